@@ -1,17 +1,38 @@
 // Cereka/Cereka.hpp — public engine API
 #pragma once
 
+#include "compiler/asset_manifest.hpp"
 #include "compiler/vn_instruction.hpp"
+#include "latency_histogram.hpp"
+#include <cstdint>
 #include <string>
 
 namespace cereka {
 
 struct CerekaEvent {
-    enum Type { Quit, KeyDown, MouseDown, Unknown };
+    enum Type {
+        Quit,
+        KeyDown,
+        KeyUp,
+        MouseDown,
+        MouseUp,
+        MouseMove,  // at most one per frame, at the pointer's latest position
+        MouseWheel,
+        TextInput,
+        GamepadDown,
+        GamepadUp,
+        Unknown
+    };
     Type type = Unknown;
-    int key = 0;
+    int key = 0;  // SDL keycode, mouse button or gamepad button
+    bool repeat = false;  // KeyDown generated by key repeat
     float mouseX = 0.f;
     float mouseY = 0.f;
+    float wheelY = 0.f;  // MouseWheel: positive scrolls away from the user
+    std::string text;    // TextInput, UTF-8
+    // When the input happened, on the clock of CerekaEngine::LastPresentTime
+    // (nanoseconds). A coalesced MouseMove carries its oldest motion's time.
+    std::uint64_t timestamp = 0;
 };
 
 enum class CerekaState {
@@ -22,7 +43,8 @@ enum class CerekaState {
     Finished,
     Quit,
     SaveMenuState,
-    LoadMenuState
+    LoadMenuState,
+    COUNT  // number of states; not a state
 };
 
 // Forward-declared here; fully defined in src/engine_impl.hpp (private)
@@ -33,19 +55,35 @@ class CerekaEngine {
     CerekaEngine();
     ~CerekaEngine();
 
+    // A non-empty entryScript is compiled on a worker while the window,
+    // renderer and audio device come up; collect it with LoadEntryScript or
+    // TakeCompiledScript.
     bool InitGame(const char *title,
                   int w,
                   int h,
-                  bool fullscreen = false);
+                  bool fullscreen = false,
+                  const std::string &entryScript = {});
     void ShutDown();
 
+    // Only events the engine acts on are returned; mouse motion is folded
+    // into one MouseMove per drain of the queue.
     bool PollEvent(CerekaEvent &e);
     void Present();
+    // When the last Present returned, in nanoseconds on the clock of
+    // CerekaEvent::timestamp; the difference is an input's latency.
+    std::uint64_t LastPresentTime() const;
 
     int Width() const;
     int Height() const;
 
     void LoadCompiledScript(const std::vector<scenario::Instruction> &compiled);
+    // Waits for the compile started by InitGame. Empty if none was started
+    // or it failed.
+    std::vector<scenario::Instruction> TakeCompiledScript();
+    // Waits for the compile started by InitGame and loads it together with
+    // the asset manifest built alongside. False if none was started or it
+    // failed.
+    bool LoadEntryScript();
     void LoadScript(const std::string &filename);
     void TickScript();
 
@@ -58,6 +96,20 @@ class CerekaEngine {
     const std::string &CurrentText() const;
     size_t ButtonCount() const;
     size_t ProgramCounter() const;
+    // What each label and straight-line region of the loaded script uses.
+    const scenario::AssetManifest &Manifest() const;
+    // Milliseconds from launch to the first presented frame that accepts
+    // input (dialogue or menu); negative until then.
+    double TimeToInteractiveMs() const;
+    // Time from an input that changed what is shown (text advance, menu
+    // choice, opening or paging the save overlay) to the Present of the
+    // first frame showing it, over the whole session.
+    const LatencyHistogram &InputLatency() const;
+
+    // Kept across playthroughs. HasSeenLine takes the pc of a say / narrate.
+    bool HasSeenLine(size_t pc) const;
+    bool IsUnlocked(const std::string &name) const;
+    bool HasReachedEnding(const std::string &name) const;
 
     bool IsGameFinished() const;
     bool IsGameQuit() const;
@@ -65,6 +117,16 @@ class CerekaEngine {
 
     bool SaveGame(int slot);
     bool LoadGame(int slot);
+    // Continue from the autosave journal written at every line of the last
+    // session (including one that crashed). Call after LoadCompiledScript;
+    // false, with the script left at its start, if there is nothing to resume.
+    bool ResumeAutosave();
+    // Dev mode: watch the scripts the entry script compiled from and, when
+    // one is saved, recompile it and swap the program in place, keeping the
+    // position (mapped through labels and source lines), variables, scene
+    // and audio; ui settings are re-applied. Call after TakeCompiledScript;
+    // false if InitGame was given no entry script.
+    bool EnableHotReload();
 
    private:
     CerekaImpl *pImplementation;
@@ -7,6 +7,7 @@
 #include <QFrame>
 #include <QGraphicsOpacityEffect>
 #include <QHBoxLayout>
+#include <QImage>
 #include <QInputDialog>
 #include <QLabel>
 #include <QLineEdit>
@@ -23,6 +24,8 @@
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include "archive/crpak.hpp"
+#include "archive/crtex.hpp"
 #include "config.hpp"
 #include "embedded_assets.h"
 #include "project_manager.hpp"
@@ -682,7 +685,8 @@ private:
         std::thread([this]() {
             std::string runner = findGameRunner();
             fs::path path = ProjectManager::instance().currentPath();
-            appendLog("$ " + runner + " " + path.string());
+            // --dev: the runner swaps in edited scripts without a restart.
+            appendLog("$ " + runner + " --dev " + path.string());
             QMetaObject::invokeMethod(this, [this]() { updateLog(); }, Qt::QueuedConnection);
 
             auto drainPipe = [this](auto readFn) {
@@ -727,7 +731,7 @@ private:
             si.hStdError  = hWrite;
             si.dwFlags    = STARTF_USESTDHANDLES;
 
-            std::string cmd = "\"" + runner + "\" \"" + path.string() + "\"";
+            std::string cmd = "\"" + runner + "\" --dev \"" + path.string() + "\"";
             BOOL ok = CreateProcessA(NULL, (char *)cmd.c_str(), NULL, NULL, TRUE, 0,
                                      NULL, path.string().c_str(), &si, &pi);
             CloseHandle(hWrite);
@@ -755,7 +759,8 @@ private:
                     dup2(pipefd[1], STDERR_FILENO);
                     ::close(pipefd[1]);
                     chdir(path.string().c_str());
-                    execlp(runner.c_str(), runner.c_str(), path.string().c_str(), nullptr);
+                    execlp(runner.c_str(), runner.c_str(), "--dev", path.string().c_str(),
+                           nullptr);
                     _exit(127);
                 } else if (pid > 0) {
                     ::close(pipefd[1]);
@@ -874,25 +879,89 @@ private:
                 appendLog("Copying project files...");
                 QMetaObject::invokeMethod(this, [this]() { updateLog(); }, Qt::QueuedConnection);
 
+                // Everything under assets/ goes into one archive except scripts,
+                // which the runtime compiles from loose files.
+                std::vector<cereka::crpak::WriteItem> packed;
                 std::function<void(const fs::path &, const fs::path &)> copyTree;
                 copyTree = [&](const fs::path &src, const fs::path &dst) {
-                    fs::create_directories(dst, ec);
                     for (auto &entry : fs::directory_iterator(src, ec)) {
                         if (entry.path().filename() == "saves")
                             continue;
+                        std::string rel =
+                            fs::relative(entry.path(), projectDir).generic_string();
                         if (entry.is_directory(ec)) {
                             copyTree(entry.path(), dst / entry.path().filename());
+                        } else if (rel.rfind("assets/", 0) == 0 &&
+                                   entry.path().extension() != ".crka") {
+                            packed.push_back({rel, entry.path()});
                         } else {
+                            fs::create_directories(dst, ec);
                             fs::copy_file(entry.path(), dst / entry.path().filename(),
                                           fs::copy_options::overwrite_existing, ec);
                             if (!ec)
-                                appendLog("  + " +
-                                          fs::relative(entry.path(), projectDir).string());
+                                appendLog("  + " + rel);
                         }
                     }
                 };
                 copyTree(projectDir, stagingDir);
 
+                // Pre-decode images so the runtime copies pixels instead of
+                // inflating PNGs. The originals stay in the project untouched.
+                fs::path texDir = projectDir.parent_path() / (stagingName + "-crtex");
+                fs::remove_all(texDir, ec);
+                fs::create_directories(texDir, ec);
+                int converted = 0;
+                for (auto &item : packed) {
+                    if (!cereka::crtex::IsConvertible(item.path))
+                        continue;
+                    QImage img(QString::fromStdString(item.source.string()));
+                    if (img.isNull()) {
+                        appendLog("[warn] Cannot decode " + item.path + ", packing as-is");
+                        continue;
+                    }
+                    img = img.convertToFormat(QImage::Format_RGBA8888);
+                    std::vector<std::uint8_t> encoded;
+                    cereka::crtex::Encode(img.constBits(), img.width(), img.height(),
+                                          (int)img.bytesPerLine(), true, encoded);
+
+                    // Written beside its final name and renamed once complete, so a
+                    // full disk never leaves a truncated texture to be packed.
+                    fs::path out = texDir / (std::to_string(converted) + ".crtex");
+                    fs::path tmp = out;
+                    tmp += ".tmp";
+                    std::ofstream file(tmp, std::ios::binary);
+                    file.write((const char *)encoded.data(), (std::streamsize)encoded.size());
+                    file.close();
+                    if (file)
+                        fs::rename(tmp, out, ec);
+                    if (!file || ec) {
+                        fs::remove(tmp, ec);
+                        appendLog("[warn] Cannot write pre-decoded " + item.path +
+                                  ", packing as-is");
+                        continue;
+                    }
+                    ++converted;
+                    item.path += cereka::crtex::EXTENSION;
+                    item.source = out;
+                }
+                appendLog("Pre-decoded " + std::to_string(converted) + " images");
+
+                appendLog("Packing " + std::to_string(packed.size()) + " assets into " +
+                          cereka::crpak::DEFAULT_NAME + "...");
+                QMetaObject::invokeMethod(this, [this]() { updateLog(); }, Qt::QueuedConnection);
+
+                std::string packError;
+                bool packOk = cereka::crpak::Write(stagingDir / cereka::crpak::DEFAULT_NAME,
+                                                   packed, packError);
+                fs::remove_all(texDir, ec);
+                if (!packOk) {
+                    appendLog("[ERROR] " + packError);
+                    fs::remove_all(stagingDir, ec);
+                    QMetaObject::invokeMethod(
+                        this, [this]() { updateLog(); }, Qt::QueuedConnection);
+                    continue;
+                }
+
                 appendLog("Creating archive...");
                 QMetaObject::invokeMethod(this, [this]() { updateLog(); }, Qt::QueuedConnection);
 
@@ -107,7 +107,8 @@ static const char *kMainScriptTemplate =
 ;   Scene:         bg, char, hide char, bgm, sfx
 ;   Dialogue:       say, narrate
 ;   Menus:         menu, button goto <label>, button exit
-;   Save/Load:     save_menu, load_menu, save <1-10>, load <1-10>
+;   Save/Load:     save_menu, load_menu, save <N>, load <N>
+;   Global:        unlock <name>, ending <name>
 ;
 ; Delete what you don't need and write your story.
 ; ================================================================
@@ -182,10 +183,15 @@ narrate "  assets/fonts/        — font files (.ttf, .otf)"
 narrate "  assets/ui/           — optional UI images (textbox, buttons...)"
 narrate "  saves/               — save files, auto-created when you save"
 
-; BG FADE — crossfade to a new background over <seconds>.
+; BG FADE — fade through black to a new background over <seconds>.
 bg placeholder_bg.png fade 1.0
 narrate "That background faded in over 1 second."
 
+; BG DISSOLVE — blend the whole old scene into the new one over <seconds>.
+; Lines right after it (char, hide char) become part of the incoming scene.
+bg placeholder_bg.png dissolve 1.0
+narrate "That one dissolved instead of fading through black."
+
 ; CHAR — show a character sprite.
 ; Re-running char with the same ID moves it to the new position.
 ; Syntax: char <ID> [left|center|right] <filename>
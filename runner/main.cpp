@@ -75,6 +75,7 @@ parseConfig(const std::string &path)
 // Usage:
 //   CerekaGame                      — uses current working directory
 //   CerekaGame /path/to/game        — explicit project directory
+//   CerekaGame --dev [dir]          — hot-reload scripts when they are saved
 // ---------------------------------------------------------------------------
 int main(int argc,
          char **argv)
@@ -95,10 +96,15 @@ int main(int argc,
     // project root
     // ----------------------------------------------------
     std::string projectRoot;
+    bool dev = false;
 
-    if (argc >= 2)
-        projectRoot = fs::absolute(argv[1]).lexically_normal().string();
-    else
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--dev")
+            dev = true;
+        else
+            projectRoot = fs::absolute(argv[i]).lexically_normal().string();
+    }
+    if (projectRoot.empty())
         projectRoot = exeDir().lexically_normal().string();
 
     L("projectRoot = " + projectRoot);
@@ -145,7 +151,10 @@ int main(int argc,
 
     cereka::CerekaEngine engine;
 
-    if (!engine.InitGame(title.c_str(), width, height, fullscreen)) {
+    L("checking entry exists = " + std::string(fs::exists(entry) ? "true" : "false"));
+
+    // The entry script compiles on a worker while the window comes up.
+    if (!engine.InitGame(title.c_str(), width, height, fullscreen, entry)) {
         L("[FATAL] InitGame FAILED");
         return 1;
     }
@@ -157,12 +166,8 @@ int main(int argc,
     // ----------------------------------------------------
     L("STEP: compile script");
 
-    L("checking entry exists = " + std::string(fs::exists(entry) ? "true" : "false"));
-
-    auto script = cereka::scenario::CompileVNScript(entry);
-
-    if (script.empty()) {
-        L("[FATAL] CompileVNScript returned empty");
+    if (!engine.LoadEntryScript()) {
+        L("[FATAL] compiled script is empty");
         return 1;
     }
 
@@ -173,7 +178,13 @@ int main(int argc,
     // ----------------------------------------------------
     L("STEP: running script");
 
-    engine.LoadCompiledScript(script);
+    // Pick up where the last session stopped, even if it crashed.
+    bool resume = cfg.count("resume") ? (cfg["resume"] != "false") : true;
+    if (resume && engine.ResumeAutosave())
+        L("resumed from autosave");
+
+    if (dev && engine.EnableHotReload())
+        L("dev mode: scripts reload when saved");
 
     while (!engine.IsGameFinished()) {
         cereka::CerekaEvent e;
@@ -187,6 +198,10 @@ int main(int argc,
     }
 
     L(engine.IsGameQuit() ? "GAME QUIT" : "GAME FINISHED");
+    if (engine.TimeToInteractiveMs() >= 0.0)
+        L("time to interactive = " + std::to_string((int)engine.TimeToInteractiveMs()) + " ms");
+    if (engine.InputLatency().Count() > 0)
+        L(engine.InputLatency().Report());
 
     engine.ShutDown();
     return 0;
@@ -183,24 +183,27 @@ end
 --    Each AST node carries `kind` plus kind-specific fields and `line`/`col`.
 -- ============================================================================
 
+local BG_TRANSITIONS = { fade = "Fade", dissolve = "Dissolve" }
+
 local function parse_bg(ctx)
     -- bg <file>
     -- bg <file> fade <duration>
+    -- bg <file> dissolve <duration>
     local kw = take(ctx)  -- "bg"
     local file_t = expect(ctx, "IDENT", nil, "expected filename after 'bg'")
     local file = file_t.value
     local node = { kind = "Bg", file = file, line = kw.lineno, col = kw.col }
     if not eof(ctx) then
         local nxt = peek(ctx)
-        if nxt and nxt.type == "IDENT" and nxt.value == "fade" then
+        if nxt and nxt.type == "IDENT" and BG_TRANSITIONS[nxt.value] then
             take(ctx)
             local dur_t = peek(ctx)
             if not dur_t or (dur_t.type ~= "NUMBER" and dur_t.type ~= "IDENT") then
                 die(kw.lineno, (dur_t and dur_t.col) or (ctx.raw_offset + #ctx.raw),
-                    "expected duration after 'fade'")
+                    "expected duration after '" .. nxt.value .. "'")
             end
             take(ctx)
-            node.kind = "Fade"
+            node.kind = BG_TRANSITIONS[nxt.value]
             node.duration = dur_t.value
         end
     end
@@ -342,9 +345,25 @@ local function parse_single_keyword(kind)
 end
 
 local function parse_bgm(ctx)
+    -- bgm <file>
+    -- bgm <file> crossfade <duration>
     local kw = take(ctx)
     local f = expect(ctx, "IDENT", nil, "expected filename after 'bgm'")
-    return { kind = "PlayBgm", file = f.value, line = kw.lineno, col = kw.col }
+    local node = { kind = "PlayBgm", file = f.value, line = kw.lineno, col = kw.col }
+    if not eof(ctx) then
+        local nxt = peek(ctx)
+        if nxt and nxt.type == "IDENT" and nxt.value == "crossfade" then
+            take(ctx)
+            local dur_t = peek(ctx)
+            if not dur_t or (dur_t.type ~= "NUMBER" and dur_t.type ~= "IDENT") then
+                die(kw.lineno, (dur_t and dur_t.col) or (ctx.raw_offset + #ctx.raw),
+                    "expected duration after 'crossfade'")
+            end
+            take(ctx)
+            node.crossfade = dur_t.value
+        end
+    end
+    return node
 end
 
 local function parse_sfx(ctx)
@@ -353,6 +372,16 @@ local function parse_sfx(ctx)
     return { kind = "PlaySfx", file = f.value, line = kw.lineno, col = kw.col }
 end
 
+local function parse_preload_sfx(ctx)
+    -- preload_sfx <file> [<file> ...]
+    local kw = take(ctx)
+    local files = { expect(ctx, "IDENT", nil, "expected filename after 'preload_sfx'").value }
+    while not eof(ctx) do
+        files[#files + 1] = expect(ctx, "IDENT", nil, "expected filename").value
+    end
+    return { kind = "PreloadSfx", files = files, line = kw.lineno, col = kw.col }
+end
+
 local function parse_save(ctx)
     local kw = take(ctx)
     local n = expect(ctx, "NUMBER", nil, "expected slot number after 'save'")
@@ -365,6 +394,20 @@ local function parse_load(ctx)
     return { kind = "Load", slot = n.value, line = kw.lineno, col = kw.col }
 end
 
+local function parse_unlock(ctx)
+    -- unlock <name>
+    local kw = take(ctx)
+    local n = expect(ctx, "IDENT", nil, "expected name after 'unlock'")
+    return { kind = "Unlock", name = n.value, line = kw.lineno, col = kw.col }
+end
+
+local function parse_ending(ctx)
+    -- ending <name>
+    local kw = take(ctx)
+    local n = expect(ctx, "IDENT", nil, "expected name after 'ending'")
+    return { kind = "Ending", name = n.value, line = kw.lineno, col = kw.col }
+end
+
 local function parse_menu_button(ctx)
     local kw = take(ctx)  -- "button"
     local text_t = expect(ctx, "STRING", nil, 'expected "text" after button')
@@ -389,27 +432,30 @@ end
 -- ============================================================================
 
 local STMT_HANDLERS = {
-    bg        = parse_bg,
-    char      = parse_char,
-    hide      = parse_hide_char,
-    say       = parse_say,
-    narrate   = parse_narrate,
-    label     = parse_label,
-    jump      = parse_jump,
-    include   = parse_include,
-    call      = parse_call,
-    set       = parse_set,
-    ["if"]    = parse_if,
-    ["else"]  = parse_single_keyword("Else"),
-    endif     = parse_single_keyword("Endif"),
-    bgm       = parse_bgm,
-    stop_bgm  = parse_single_keyword("StopBgm"),
-    sfx       = parse_sfx,
-    ["end"]   = parse_single_keyword("End"),
-    save_menu = parse_single_keyword("SaveMenu"),
-    load_menu = parse_single_keyword("LoadMenu"),
-    save      = parse_save,
-    load      = parse_load,
+    bg          = parse_bg,
+    char        = parse_char,
+    hide        = parse_hide_char,
+    say         = parse_say,
+    narrate     = parse_narrate,
+    label       = parse_label,
+    jump        = parse_jump,
+    include     = parse_include,
+    call        = parse_call,
+    set         = parse_set,
+    ["if"]      = parse_if,
+    ["else"]    = parse_single_keyword("Else"),
+    endif       = parse_single_keyword("Endif"),
+    bgm         = parse_bgm,
+    stop_bgm    = parse_single_keyword("StopBgm"),
+    sfx         = parse_sfx,
+    preload_sfx = parse_preload_sfx,
+    ["end"]     = parse_single_keyword("End"),
+    save_menu   = parse_single_keyword("SaveMenu"),
+    load_menu   = parse_single_keyword("LoadMenu"),
+    save        = parse_save,
+    load        = parse_load,
+    unlock      = parse_unlock,
+    ending      = parse_ending,
 }
 
 local MENU_HANDLERS = {
@@ -586,6 +632,9 @@ LOWERERS = {
     Fade = function(n, out)
         emit(out, { op = "FADE", a = n.file, b = n.duration, line = n.line, col = n.col })
     end,
+    Dissolve = function(n, out)
+        emit(out, { op = "DISSOLVE", a = n.file, b = n.duration, line = n.line, col = n.col })
+    end,
     Char = function(n, out)
         emit(out, { op = "CHAR", a = n.id, b = n.file, c = n.pos, line = n.line, col = n.col })
     end,
@@ -627,7 +676,7 @@ LOWERERS = {
         emit(out, { op = "ENDIF", line = n.line, col = n.col })
     end,
     PlayBgm = function(n, out)
-        emit(out, { op = "PLAY_BGM", a = n.file, line = n.line, col = n.col })
+        emit(out, { op = "PLAY_BGM", a = n.file, b = n.crossfade, line = n.line, col = n.col })
     end,
     StopBgm = function(n, out)
         emit(out, { op = "STOP_BGM", line = n.line, col = n.col })
@@ -635,6 +684,11 @@ LOWERERS = {
     PlaySfx = function(n, out)
         emit(out, { op = "PLAY_SFX", a = n.file, line = n.line, col = n.col })
     end,
+    PreloadSfx = function(n, out)
+        for _, file in ipairs(n.files) do
+            emit(out, { op = "PRELOAD_SFX", a = file, line = n.line, col = n.col })
+        end
+    end,
     ["End"] = function(n, out)
         emit(out, { op = "END", line = n.line, col = n.col })
     end,
@@ -650,6 +704,12 @@ LOWERERS = {
     Load = function(n, out)
         emit(out, { op = "LOAD", a = n.slot, line = n.line, col = n.col })
     end,
+    Unlock = function(n, out)
+        emit(out, { op = "UNLOCK", a = n.name, line = n.line, col = n.col })
+    end,
+    Ending = function(n, out)
+        emit(out, { op = "ENDING", a = n.name, line = n.line, col = n.col })
+    end,
     Menu = function(n, out)
         emit(out, { op = "MENU", line = n.line, col = n.col })
         for _, child in ipairs(n.children) do
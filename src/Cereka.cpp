@@ -9,43 +9,136 @@
 bool Impl::InitGame(const char *title,
                     int width,
                     int height,
-                    bool fullscreen)
-{
-    video::init_video();
-    video::create_window(title, fullscreen, width, height);
-    window = video::window;
-    screenWidth = video::width;
-    screenHeight = video::height;
+                    bool fullscreen,
+                    const std::string &entryScript)
+{
+    startup_profile::Span total("InitGame");
+
+    // Packaged games ship their assets in one archive; loose files are the
+    // fallback. Mounted first because the script compile checks against it.
+    asset_pack::Mount(crpak::DEFAULT_NAME);
+
+    // Compiling touches neither SDL nor engine state, so it overlaps
+    // everything below; LoadEntryScript or TakeCompiledScript collects it.
+    // The cache it fills lets EnableHotReload watch and recompile cheaply.
+    this->entryScript = entryScript;
+    if (!entryScript.empty()) {
+        compiledScript = std::async(std::launch::async, [this, entryScript] {
+            startup_profile::Span span("compile " + entryScript);
+            CompiledProgram out;
+            out.program = scenario::CompileVNScript(entryScript, &compileCache, &out.manifest);
+            return out;
+        });
+    }
+
+    {
+        startup_profile::Span span("video init");
+        video::init_video();
+    }
+    FilterEvents();
+
+    // Opening the audio device can block for a long time on some backends.
+    // The subsystem itself is brought up here so SDL init stays on this
+    // thread; only the device open runs alongside window creation.
+    SDL_InitSubSystem(SDL_INIT_AUDIO);
+    std::future<bool> audioReady = std::async(std::launch::async, [this] {
+        startup_profile::Span span("audio device");
+        return audio.Init();
+    });
+
+    {
+        startup_profile::Span span("window");
+        video::create_window(title, fullscreen, width, height);
+        window = video::window;
+        screenWidth = video::width;
+        screenHeight = video::height;
+    }
 
     text_renderer::init_ttf();
 
-    renderer = CreateBestRenderer(window);
-    if (!renderer)
-        throw engine::error("All renderer attempts failed");
+    {
+        startup_profile::Span span("renderer");
+        renderer = CreateBestRenderer(window);
+        if (!renderer)
+            throw engine::error("All renderer attempts failed");
+    }
+
+    textures.Init(renderer);
+    auto renderText = [this](const std::string &text, SDL_Color c) { return RenderText(text, c); };
+    dialogueUi.Init(renderer, renderText);
+    menuUi.Init(renderer, renderText);
+    saveUi.Init(renderer, renderText);
+
+    {
+        startup_profile::Span span("font and ui config");
+        LoadFont(uiCfg.fontSize);
+        InitConfigManager();
+    }
 
-    LoadFont(uiCfg.fontSize);
-    InitConfigManager();
+    scene.Init(renderer, &textures);
+    audioReady.get();
 
-    scene.Init(renderer);
-    audio.Init();
+    prefetcher.Start(audio.Mixer());
+    textures.AttachPrefetcher(&prefetcher);
+    audio.AttachPrefetcher(&prefetcher);
+    saveWriter.Start();
+    journal.Start();
+    if (globalData.Open(saveIndex.Dir()))
+        globalData.Start();
+
+    // Pads already plugged in arrive as SDL_EVENT_GAMEPAD_ADDED.
+    if (!SDL_InitSubSystem(SDL_INIT_GAMEPAD))
+        std::cerr << "[CEREKA] Gamepad support unavailable: " << SDL_GetError() << "\n";
     return true;
 }
 
 void Impl::ShutDown()
 {
-    auto destroyTex = [](SDL_Texture *&t) {
-        if (t) {
-            SDL_DestroyTexture(t);
-            t = nullptr;
-        }
+    auto releaseTex = [this](SDL_Texture *&t) {
+        textures.Release(t);
+        t = nullptr;
     };
 
-    destroyTex(uiCfg.textbox.image);
-    destroyTex(uiCfg.namebox.image);
-    destroyTex(uiCfg.button.image);
-    destroyTex(uiCfg.button.hoverImage);
+    releaseTex(uiCfg.textbox.image);
+    releaseTex(uiCfg.namebox.image);
+    releaseTex(uiCfg.button.image);
+    releaseTex(uiCfg.button.hoverImage);
+    ReleaseSlotThumbs();
+    DestroyBackdrops();
+    if (thumbnailTarget) {
+        SDL_DestroyTexture(thumbnailTarget);
+        thumbnailTarget = nullptr;
+    }
+
+    // A finished playthrough has nothing to resume. Otherwise fold the
+    // journal into one snapshot so the next launch replays a single record.
+    if (states.baseType() == CerekaState::Finished)
+        journal.Discard();
+    else
+        journal.Compact();
+    journal.Stop();
+    globalData.Close();
+
+    // A dev-mode recompile may still be using the compile cache.
+    scriptWatcher.Stop();
+    if (reloadedScript.valid())
+        reloadedScript.wait();
+
+    // Lets any save still being written reach the disk.
+    saveWriter.Stop();
+
+    // Workers may still hold the mixer; stop them before audio goes away.
+    audio.CancelLoads();
+    prefetcher.Stop();
+    textures.AttachPrefetcher(nullptr);
+    audio.AttachPrefetcher(nullptr);
 
     scene.Shutdown();
+    dialogueUi.Shutdown();
+    menuUi.Shutdown();
+    saveUi.Shutdown();
+    ReleaseUiPatches();
+    textures.Shutdown();
 
     if (font) {
         TTF_CloseFont(font);
@@ -62,6 +155,13 @@ void Impl::ShutDown()
 
     audio.Shutdown();
 
+    for (SDL_Gamepad *pad : gamepads)
+        SDL_CloseGamepad(pad);
+    gamepads.clear();
+
+    // After every font and audio stream reading from the archive is closed.
+    asset_pack::Unmount();
+
     TTF_Quit();
     SDL_Quit();
 }
@@ -70,35 +170,189 @@ void Impl::ShutDown()
 // Events
 // ---------------------------------------------------------------------------
 
+// SDL events nothing in the engine reads. Dropped before they are queued,
+// so high-rate sources (pens, sensors, analog sticks, touch) cost nothing;
+// touch still reaches the engine as the mouse events SDL synthesizes.
+static constexpr SDL_EventType IGNORED_EVENTS[] = {
+    SDL_EVENT_TEXT_EDITING,
+    SDL_EVENT_FINGER_DOWN,
+    SDL_EVENT_FINGER_UP,
+    SDL_EVENT_FINGER_MOTION,
+    SDL_EVENT_FINGER_CANCELED,
+    SDL_EVENT_PEN_PROXIMITY_IN,
+    SDL_EVENT_PEN_PROXIMITY_OUT,
+    SDL_EVENT_PEN_DOWN,
+    SDL_EVENT_PEN_UP,
+    SDL_EVENT_PEN_BUTTON_DOWN,
+    SDL_EVENT_PEN_BUTTON_UP,
+    SDL_EVENT_PEN_MOTION,
+    SDL_EVENT_PEN_AXIS,
+    SDL_EVENT_SENSOR_UPDATE,
+    SDL_EVENT_JOYSTICK_AXIS_MOTION,
+    SDL_EVENT_JOYSTICK_BALL_MOTION,
+    SDL_EVENT_JOYSTICK_HAT_MOTION,
+    SDL_EVENT_JOYSTICK_BUTTON_DOWN,
+    SDL_EVENT_JOYSTICK_BUTTON_UP,
+    SDL_EVENT_GAMEPAD_AXIS_MOTION,
+    SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN,
+    SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION,
+    SDL_EVENT_GAMEPAD_TOUCHPAD_UP,
+    SDL_EVENT_GAMEPAD_SENSOR_UPDATE,
+    SDL_EVENT_DROP_FILE,
+    SDL_EVENT_DROP_TEXT,
+    SDL_EVENT_DROP_BEGIN,
+    SDL_EVENT_DROP_COMPLETE,
+    SDL_EVENT_DROP_POSITION,
+    SDL_EVENT_CLIPBOARD_UPDATE,
+};
+
+void Impl::FilterEvents()
+{
+    for (SDL_EventType type : IGNORED_EVENTS)
+        SDL_SetEventEnabled(type, false);
+}
+
+// Drains SDL's queue far enough to return one event. Mouse motion is held
+// back and merged with any that follows; it is returned just before the next
+// event of another kind (keeping order with clicks) or when the queue is
+// empty, so a frame dispatches at most one MouseMove per run of motion.
 bool Impl::PollEvent(cereka::CerekaEvent &e)
 {
+    if (heldEvent) {
+        e = std::move(*heldEvent);
+        heldEvent.reset();
+        return true;
+    }
+
     SDL_Event sdl;
-    if (!SDL_PollEvent(&sdl))
-        return false;
+    while (SDL_PollEvent(&sdl)) {
+        cereka::CerekaEvent next;
+        if (!TranslateEvent(sdl, next))
+            continue;
+        if (next.type == cereka::CerekaEvent::MouseMove) {
+            if (pendingMotion) {
+                pendingMotion->mouseX = next.mouseX;
+                pendingMotion->mouseY = next.mouseY;
+            }
+            else
+                pendingMotion = next;
+            continue;
+        }
+        if (pendingMotion) {
+            heldEvent = std::move(next);
+            e = *pendingMotion;
+            pendingMotion.reset();
+            return true;
+        }
+        e = std::move(next);
+        return true;
+    }
 
+    if (pendingMotion) {
+        e = *pendingMotion;
+        pendingMotion.reset();
+        return true;
+    }
+    return false;
+}
+
+// False for events handled here (window, device and gamepad changes) and
+// for anything the engine does not act on.
+bool Impl::TranslateEvent(const SDL_Event &sdl,
+                          cereka::CerekaEvent &e)
+{
+    using cereka::CerekaEvent;
+
+    e.timestamp = sdl.common.timestamp;
     switch (sdl.type) {
         case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
         case SDL_EVENT_QUIT:
-            e = {cereka::CerekaEvent::Quit, 0};
+            e.type = CerekaEvent::Quit;
             return true;
         case SDL_EVENT_KEY_DOWN:
-            e = {cereka::CerekaEvent::KeyDown, int(sdl.key.key)};
+        case SDL_EVENT_KEY_UP:
+            e.type = sdl.type == SDL_EVENT_KEY_DOWN ? CerekaEvent::KeyDown : CerekaEvent::KeyUp;
+            e.key = int(sdl.key.key);
+            e.repeat = sdl.key.repeat;
             return true;
         case SDL_EVENT_MOUSE_BUTTON_DOWN:
-            e.type = cereka::CerekaEvent::MouseDown;
-            e.key = 0;
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            e.type = sdl.type == SDL_EVENT_MOUSE_BUTTON_DOWN ? CerekaEvent::MouseDown
+                                                              : CerekaEvent::MouseUp;
+            e.key = sdl.button.button;
             e.mouseX = sdl.button.x;
             e.mouseY = sdl.button.y;
             return true;
-        default:
-            e = {cereka::CerekaEvent::Unknown, 0};
+        case SDL_EVENT_MOUSE_MOTION:
+            e.type = CerekaEvent::MouseMove;
+            e.mouseX = sdl.motion.x;
+            e.mouseY = sdl.motion.y;
+            return true;
+        case SDL_EVENT_MOUSE_WHEEL:
+            e.type = CerekaEvent::MouseWheel;
+            e.mouseX = sdl.wheel.mouse_x;
+            e.mouseY = sdl.wheel.mouse_y;
+            e.wheelY =
+                sdl.wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -sdl.wheel.y : sdl.wheel.y;
+            return e.wheelY != 0.f;
+        case SDL_EVENT_TEXT_INPUT:
+            e.type = CerekaEvent::TextInput;
+            e.text = sdl.text.text;
+            return true;
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+            e.type = sdl.type == SDL_EVENT_GAMEPAD_BUTTON_DOWN ? CerekaEvent::GamepadDown
+                                                                : CerekaEvent::GamepadUp;
+            e.key = sdl.gbutton.button;
             return true;
+        case SDL_EVENT_GAMEPAD_ADDED:
+            if (SDL_Gamepad *pad = SDL_OpenGamepad(sdl.gdevice.which))
+                gamepads.push_back(pad);
+            return false;
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            if (SDL_Gamepad *pad = SDL_GetGamepadFromID(sdl.gdevice.which)) {
+                std::erase(gamepads, pad);
+                SDL_CloseGamepad(pad);
+            }
+            return false;
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        case SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED: {
+            // Reload visible images at the new output resolution.
+            int pw = 0, ph = 0;
+            if (SDL_GetRenderOutputSize(renderer, &pw, &ph))
+                scene.SetTargetSize(pw, ph);
+            return false;
+        }
+        case SDL_EVENT_RENDER_TARGETS_RESET:
+        case SDL_EVENT_RENDER_DEVICE_RESET:
+            // Target textures lost their contents; the UI layers repaint.
+            dialogueUi.Invalidate();
+            menuUi.Invalidate();
+            saveUi.Invalidate();
+            RecaptureBackdrops();
+            return false;
+        default:
+            return false;
     }
 }
 
 void Impl::Present()
 {
     SDL_RenderPresent(renderer);
+    lastPresentNs = SDL_GetTicksNS();
+    if (inputAwaitingPresentNs) {
+        inputLatency.Record(lastPresentNs - std::min(inputAwaitingPresentNs, lastPresentNs));
+        inputAwaitingPresentNs = 0;
+    }
+
+    if (timeToInteractiveMs < 0.0 &&
+        (states.currentType() == CerekaState::WaitingForInput ||
+         states.currentType() == CerekaState::InMenu))
+    {
+        timeToInteractiveMs = startup_profile::SinceLaunchMs();
+        std::cerr << "[CEREKA] startup time to first interactive frame: "
+                  << (int)timeToInteractiveMs << " ms\n";
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -187,7 +441,9 @@ void Impl::EnterMenu()
     while (scan < scriptInterpreter.program.size()) {
         const auto &ins = scriptInterpreter.program[scan];
 
-        if (ins.op == scenario::Op::BG || ins.op == scenario::Op::FADE) {
+        if (ins.op == scenario::Op::BG || ins.op == scenario::Op::FADE ||
+            ins.op == scenario::Op::DISSOLVE)
+        {
             // Instant swap inside menu — no game loop available to animate
             scene.ShowBackground(ins.a);
             scan++;
@@ -209,6 +465,8 @@ void Impl::EnterMenu()
 void Impl::ExitMenu()
 {
     menu.Close();
+    menuUi.Clear();
+    menuUi.SetLayoutKey(0);
 }
 
 // ---------------------------------------------------------------------------
@@ -224,9 +482,10 @@ cereka::CerekaEngine::~CerekaEngine()
 bool cereka::CerekaEngine::InitGame(const char *title,
                                     int w,
                                     int h,
-                                    bool fullscreen)
+                                    bool fullscreen,
+                                    const std::string &entryScript)
 {
-    return pImplementation->InitGame(title, w, h, fullscreen);
+    return pImplementation->InitGame(title, w, h, fullscreen, entryScript);
 }
 
 void cereka::CerekaEngine::ShutDown()
@@ -257,6 +516,16 @@ void cereka::CerekaEngine::LoadCompiledScript(const std::vector<scenario::Instru
     pImplementation->LoadCompiledScript(compiled);
 }
 
+std::vector<cereka::scenario::Instruction> cereka::CerekaEngine::TakeCompiledScript()
+{
+    return pImplementation->TakeCompiledScript();
+}
+
+bool cereka::CerekaEngine::LoadEntryScript()
+{
+    return pImplementation->LoadEntryScript();
+}
+
 void cereka::CerekaEngine::LoadScript(const std::string &filename)
 {
     pImplementation->LoadScript(filename);
@@ -300,15 +569,35 @@ size_t cereka::CerekaEngine::ProgramCounter() const
     return pImplementation->scriptInterpreter.pc;
 }
 
+double cereka::CerekaEngine::TimeToInteractiveMs() const
+{
+    return pImplementation->timeToInteractiveMs;
+}
+
+std::uint64_t cereka::CerekaEngine::LastPresentTime() const
+{
+    return pImplementation->lastPresentNs;
+}
+
+const cereka::LatencyHistogram &cereka::CerekaEngine::InputLatency() const
+{
+    return pImplementation->inputLatency;
+}
+
+const cereka::scenario::AssetManifest &cereka::CerekaEngine::Manifest() const
+{
+    return pImplementation->manifest;
+}
+
 bool cereka::CerekaEngine::IsGameFinished() const
 {
-    return pImplementation->state == CerekaState::Finished ||
-           pImplementation->state == CerekaState::Quit;
+    CerekaState base = pImplementation->states.baseType();
+    return base == CerekaState::Finished || base == CerekaState::Quit;
 }
 
 bool cereka::CerekaEngine::IsGameQuit() const
 {
-    return pImplementation->state == CerekaState::Quit;
+    return pImplementation->states.baseType() == CerekaState::Quit;
 }
 
 bool cereka::CerekaEngine::IsFinished() const
@@ -321,6 +610,31 @@ bool cereka::CerekaEngine::SaveGame(int slot)
     return pImplementation->SaveGame(slot);
 }
 
+bool cereka::CerekaEngine::HasSeenLine(size_t pc) const
+{
+    return pImplementation->globalData.Seen(pc);
+}
+
+bool cereka::CerekaEngine::IsUnlocked(const std::string &name) const
+{
+    return pImplementation->globalData.IsUnlocked(name);
+}
+
+bool cereka::CerekaEngine::HasReachedEnding(const std::string &name) const
+{
+    return pImplementation->globalData.HasReachedEnding(name);
+}
+
+bool cereka::CerekaEngine::ResumeAutosave()
+{
+    return pImplementation->ResumeAutosave();
+}
+
+bool cereka::CerekaEngine::EnableHotReload()
+{
+    return pImplementation->EnableHotReload();
+}
+
 bool cereka::CerekaEngine::LoadGame(int slot)
 {
     return pImplementation->LoadGame(slot);
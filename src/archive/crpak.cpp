@@ -0,0 +1,162 @@
+#include "crpak.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace cereka::crpak {
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t v)
+{
+    return (v + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void padTo(std::ofstream &f,
+           std::uint64_t &pos,
+           std::uint64_t target)
+{
+    static const char zeros[ALIGNMENT] = {};
+    f.write(zeros, (std::streamsize)(target - pos));
+    pos = target;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Reading
+// ---------------------------------------------------------------------------
+
+bool View::Open(const std::uint8_t *bytes,
+                std::size_t size)
+{
+    *this = View();
+    if (!bytes || size < sizeof(Header))
+        return false;
+
+    Header h;
+    std::memcpy(&h, bytes, sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION)
+        return false;
+
+    std::uint64_t indexEnd = h.indexOffset + (std::uint64_t)h.entryCount * sizeof(Entry);
+    if (h.indexOffset % alignof(Entry) != 0 || indexEnd > size || indexEnd < h.indexOffset)
+        return false;
+    if (h.stringsOffset > size || h.stringsSize > size - h.stringsOffset)
+        return false;
+
+    const Entry *index = reinterpret_cast<const Entry *>(bytes + h.indexOffset);
+    for (std::uint32_t i = 0; i < h.entryCount; ++i) {
+        const Entry &e = index[i];
+        if (e.offset > size || e.size > size - e.offset)
+            return false;
+        if ((std::uint64_t)e.pathOffset + e.pathLength > h.stringsSize)
+            return false;
+    }
+
+    data = bytes;
+    entries = index;
+    count = h.entryCount;
+    strings = reinterpret_cast<const char *>(bytes + h.stringsOffset);
+    return true;
+}
+
+std::string_view View::PathOf(const Entry &e) const
+{
+    return {strings + e.pathOffset, e.pathLength};
+}
+
+const Entry *View::Find(std::string_view path) const
+{
+    const Entry *it = std::lower_bound(begin(), end(), path, [this](const Entry &e,
+                                                                    std::string_view p) {
+        return PathOf(e) < p;
+    });
+    if (it == end() || PathOf(*it) != path)
+        return nullptr;
+    return it;
+}
+
+// ---------------------------------------------------------------------------
+// Writing
+// ---------------------------------------------------------------------------
+
+bool Write(const std::filesystem::path &out,
+           std::vector<WriteItem> items,
+           std::string &error)
+{
+    std::sort(items.begin(), items.end(), [](const WriteItem &a, const WriteItem &b) {
+        return a.path < b.path;
+    });
+    for (std::size_t i = 1; i < items.size(); ++i) {
+        if (items[i].path == items[i - 1].path) {
+            error = "duplicate archive path: " + items[i].path;
+            return false;
+        }
+    }
+
+    std::ofstream f(out, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        error = "cannot create " + out.string();
+        return false;
+    }
+
+    auto fail = [&](const std::string &msg) {
+        error = msg;
+        f.close();
+        std::error_code ec;
+        std::filesystem::remove(out, ec);
+        return false;
+    };
+
+    Header h = {};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.entryCount = (std::uint32_t)items.size();
+    f.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    std::uint64_t pos = sizeof(h);
+
+    std::vector<Entry> index;
+    std::string strings;
+    std::vector<char> buf(1 << 16);
+    for (const WriteItem &item : items) {
+        std::ifstream in(item.source, std::ios::binary);
+        if (!in)
+            return fail("cannot read " + item.source.string());
+
+        padTo(f, pos, alignUp(pos));
+        Entry e = {};
+        e.offset = pos;
+        e.pathOffset = (std::uint32_t)strings.size();
+        e.pathLength = (std::uint32_t)item.path.size();
+        strings += item.path;
+
+        while (in) {
+            in.read(buf.data(), (std::streamsize)buf.size());
+            std::streamsize n = in.gcount();
+            f.write(buf.data(), n);
+            e.size += (std::uint64_t)n;
+        }
+        pos += e.size;
+        index.push_back(e);
+    }
+
+    padTo(f, pos, alignUp(pos));
+    h.indexOffset = pos;
+    f.write(reinterpret_cast<const char *>(index.data()),
+            (std::streamsize)(index.size() * sizeof(Entry)));
+    pos += index.size() * sizeof(Entry);
+
+    h.stringsOffset = pos;
+    h.stringsSize = strings.size();
+    f.write(strings.data(), (std::streamsize)strings.size());
+
+    f.seekp(0);
+    f.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    if (!f)
+        return fail("write failed: " + out.string());
+    return true;
+}
+
+}  // namespace cereka::crpak
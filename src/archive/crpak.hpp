@@ -0,0 +1,86 @@
+#pragma once
+// crpak.hpp — on-disk layout of .crpak asset archives
+//
+// Shared by the engine (reader) and the launcher (writer), so this stays
+// C++17 and free of SDL.
+//
+//   Header | payloads, each ALIGNMENT-aligned | Entry[entryCount] | path bytes
+//
+// Entries are sorted by path (bytewise) for binary search. Paths are
+// project-relative with '/' separators ("assets/bg/room.png"), spelled
+// exactly as the engine's loaders ask for them. Integers are little-endian
+// and the index is read in place, so archives are only portable between
+// little-endian machines (every platform the runtime ships on).
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cereka::crpak {
+
+constexpr char MAGIC[4] = {'C', 'R', 'P', 'K'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint64_t ALIGNMENT = 16;
+
+// Looked up relative to the project root (the runtime's working directory).
+constexpr const char *DEFAULT_NAME = "assets.crpak";
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+    std::uint64_t indexOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+static_assert(sizeof(Header) == 40, "crpak header layout changed");
+
+struct Entry {
+    std::uint64_t offset;  // payload start, from the beginning of the archive
+    std::uint64_t size;
+    std::uint32_t pathOffset;  // into the path bytes
+    std::uint32_t pathLength;
+};
+static_assert(sizeof(Entry) == 24, "crpak entry layout changed");
+
+// Read-only view over archive bytes (typically an mmap'd file). Does not own
+// the memory, which must outlive the view.
+class View {
+   public:
+    // Returns false if data is not a well-formed archive of this version.
+    bool Open(const std::uint8_t *data,
+              std::size_t size);
+
+    // Binary search of the index; nullptr if path is not in the archive.
+    const Entry *Find(std::string_view path) const;
+
+    const std::uint8_t *Payload(const Entry &e) const { return data + e.offset; }
+    std::string_view PathOf(const Entry &e) const;
+
+    const Entry *begin() const { return entries; }
+    const Entry *end() const { return entries + count; }
+    std::uint32_t Count() const { return count; }
+
+   private:
+    const std::uint8_t *data = nullptr;
+    const Entry *entries = nullptr;
+    std::uint32_t count = 0;
+    const char *strings = nullptr;
+};
+
+struct WriteItem {
+    std::string path;  // archive path, see above
+    std::filesystem::path source;
+};
+
+// Write items into a new archive at out. On failure returns false, sets
+// error and removes the partial file.
+bool Write(const std::filesystem::path &out,
+           std::vector<WriteItem> items,
+           std::string &error);
+
+}  // namespace cereka::crpak
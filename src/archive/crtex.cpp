@@ -0,0 +1,256 @@
+#include "crtex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace cereka::crtex {
+
+namespace {
+
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t LAST_LITERALS = 5;  // a block always ends in literals
+constexpr std::size_t MF_LIMIT = 12;      // no match may start closer to the end
+constexpr std::size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 16;
+
+std::uint32_t read32(const std::uint8_t *p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t hash4(std::uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void putLength(std::vector<std::uint8_t> &out,
+               std::size_t len)
+{
+    for (; len >= 255; len -= 255)
+        out.push_back(255);
+    out.push_back((std::uint8_t)len);
+}
+
+void putSequence(std::vector<std::uint8_t> &out,
+                 const std::uint8_t *literals,
+                 std::size_t literalLen,
+                 std::size_t offset,
+                 std::size_t matchLen)
+{
+    std::size_t extraMatch = matchLen - MIN_MATCH;
+    std::uint8_t token = (std::uint8_t)(std::min<std::size_t>(literalLen, 15) << 4);
+    if (offset)
+        token |= (std::uint8_t)std::min<std::size_t>(extraMatch, 15);
+    out.push_back(token);
+    if (literalLen >= 15)
+        putLength(out, literalLen - 15);
+    out.insert(out.end(), literals, literals + literalLen);
+    if (!offset)
+        return;
+    out.push_back((std::uint8_t)(offset & 0xff));
+    out.push_back((std::uint8_t)(offset >> 8));
+    if (extraMatch >= 15)
+        putLength(out, extraMatch - 15);
+}
+
+bool readLength(const std::uint8_t *&ip,
+                const std::uint8_t *end,
+                std::size_t &len)
+{
+    std::uint8_t b;
+    do {
+        if (ip >= end)
+            return false;
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// LZ4 block codec (greedy single-probe compressor)
+// ---------------------------------------------------------------------------
+
+void Lz4Compress(const std::uint8_t *src,
+                 std::size_t size,
+                 std::vector<std::uint8_t> &out)
+{
+    std::size_t anchor = 0;
+    if (size > MF_LIMIT) {
+        // Positions are stored +1 so zero means "empty".
+        std::vector<std::uint32_t> table((std::size_t)1 << HASH_BITS, 0);
+        std::size_t i = 0;
+        const std::size_t matchLimit = size - LAST_LITERALS;
+        while (i + MF_LIMIT <= size) {
+            std::uint32_t seq = read32(src + i);
+            std::uint32_t &slot = table[hash4(seq)];
+            std::size_t cand = slot;
+            slot = (std::uint32_t)(i + 1);
+            if (cand == 0 || i - (cand - 1) > MAX_OFFSET || read32(src + cand - 1) != seq) {
+                ++i;
+                continue;
+            }
+            --cand;
+            std::size_t len = MIN_MATCH;
+            while (i + len < matchLimit && src[cand + len] == src[i + len])
+                ++len;
+            putSequence(out, src + anchor, i - anchor, i - cand, len);
+            i += len;
+            anchor = i;
+        }
+    }
+    putSequence(out, src + anchor, size - anchor, 0, MIN_MATCH);
+}
+
+bool Lz4Decompress(const std::uint8_t *src,
+                   std::size_t srcSize,
+                   std::uint8_t *dst,
+                   std::size_t dstSize)
+{
+    const std::uint8_t *ip = src;
+    const std::uint8_t *const ipEnd = src + srcSize;
+    std::uint8_t *op = dst;
+    std::uint8_t *const opEnd = dst + dstSize;
+
+    while (ip < ipEnd) {
+        std::uint8_t token = *ip++;
+
+        std::size_t literalLen = token >> 4;
+        if (literalLen == 15 && !readLength(ip, ipEnd, literalLen))
+            return false;
+        if (literalLen > (std::size_t)(ipEnd - ip) || literalLen > (std::size_t)(opEnd - op))
+            return false;
+        std::memcpy(op, ip, literalLen);
+        ip += literalLen;
+        op += literalLen;
+        if (ip == ipEnd)
+            break;  // final sequence carries literals only
+
+        if (ipEnd - ip < 2)
+            return false;
+        std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (std::size_t)(op - dst))
+            return false;
+
+        std::size_t matchLen = token & 15;
+        if (matchLen == 15 && !readLength(ip, ipEnd, matchLen))
+            return false;
+        matchLen += MIN_MATCH;
+        if (matchLen > (std::size_t)(opEnd - op))
+            return false;
+
+        const std::uint8_t *match = op - offset;
+        if (offset >= matchLen) {
+            std::memcpy(op, match, matchLen);
+            op += matchLen;
+        }
+        else {
+            for (std::size_t k = 0; k < matchLen; ++k)  // overlapping run
+                *op++ = *match++;
+        }
+    }
+    return op == opEnd;
+}
+
+// ---------------------------------------------------------------------------
+// Texture container
+// ---------------------------------------------------------------------------
+
+bool IsConvertible(const std::string &path)
+{
+    auto dot = path.rfind('.');
+    if (dot == std::string::npos)
+        return false;
+    std::string ext = path.substr(dot + 1);
+    for (char &c : ext)
+        c = (char)std::tolower((unsigned char)c);
+    return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp";
+}
+
+void Encode(const std::uint8_t *rgba,
+            int width,
+            int height,
+            int pitch,
+            bool compress,
+            std::vector<std::uint8_t> &out)
+{
+    const std::size_t rowBytes = (std::size_t)width * 4;
+    std::vector<std::uint8_t> raw(rowBytes * height);
+    for (int y = 0; y < height; ++y)
+        std::memcpy(raw.data() + rowBytes * y, rgba + (std::size_t)pitch * y, rowBytes);
+
+    Header h = {};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.width = (std::uint32_t)width;
+    h.height = (std::uint32_t)height;
+    h.compression = Compression::None;
+
+    std::vector<std::uint8_t> packed;
+    if (compress) {
+        Lz4Compress(raw.data(), raw.size(), packed);
+        if (packed.size() < raw.size())
+            h.compression = Compression::Lz4;
+    }
+    const std::vector<std::uint8_t> &payload =
+        h.compression == Compression::Lz4 ? packed : raw;
+    h.payloadSize = payload.size();
+
+    out.resize(sizeof(h));
+    std::memcpy(out.data(), &h, sizeof(h));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+bool ReadHeader(const std::uint8_t *data,
+                std::size_t size,
+                Header &header)
+{
+    if (!data || size < sizeof(Header))
+        return false;
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+        return false;
+    if (header.width == 0 || header.height == 0 || header.width > 32768 || header.height > 32768)
+        return false;
+    if (header.payloadSize != size - sizeof(Header))
+        return false;
+    if (header.compression == Compression::None)
+        return header.payloadSize == (std::uint64_t)header.width * header.height * 4;
+    return header.compression == Compression::Lz4;
+}
+
+bool DecodePixels(const std::uint8_t *data,
+                  std::size_t size,
+                  std::uint8_t *dst,
+                  int dstPitch)
+{
+    Header h;
+    if (!ReadHeader(data, size, h))
+        return false;
+
+    const std::uint8_t *payload = data + sizeof(Header);
+    const std::size_t rowBytes = (std::size_t)h.width * 4;
+    const std::size_t total = rowBytes * h.height;
+
+    if (h.compression == Compression::Lz4 && (std::size_t)dstPitch == rowBytes)
+        return Lz4Decompress(payload, (std::size_t)h.payloadSize, dst, total);
+
+    std::vector<std::uint8_t> scratch;
+    if (h.compression == Compression::Lz4) {
+        scratch.resize(total);
+        if (!Lz4Decompress(payload, (std::size_t)h.payloadSize, scratch.data(), total))
+            return false;
+        payload = scratch.data();
+    }
+    for (std::uint32_t y = 0; y < h.height; ++y)
+        std::memcpy(dst + (std::size_t)dstPitch * y, payload + rowBytes * y, rowBytes);
+    return true;
+}
+
+}  // namespace cereka::crtex
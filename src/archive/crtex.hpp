@@ -0,0 +1,74 @@
+#pragma once
+// crtex.hpp — pre-decoded texture format written at package time
+//
+// The launcher converts PNG/JPEG assets into .crtex so the runtime copies
+// pixels instead of inflating and unfiltering them. Like crpak.hpp this is
+// shared with the launcher, so it stays C++17 and free of SDL.
+//
+//   Header | pixel payload
+//
+// Pixels are tightly packed 8-bit RGBA in R,G,B,A byte order with straight
+// (non-premultiplied) alpha, i.e. SDL_PIXELFORMAT_RGBA32. The payload is
+// either the raw rows or one LZ4 block (https://github.com/lz4/lz4, block
+// format) decompressing to them.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cereka::crtex {
+
+constexpr char MAGIC[4] = {'C', 'R', 'T', 'X'};
+constexpr std::uint32_t VERSION = 1;
+
+// Appended to the source path: "assets/bg/room.png" -> "assets/bg/room.png.crtex".
+constexpr const char *EXTENSION = ".crtex";
+
+enum class Compression : std::uint32_t { None = 0, Lz4 = 1 };
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+    Compression compression;
+    std::uint32_t reserved;
+    std::uint64_t payloadSize;
+};
+static_assert(sizeof(Header) == 32, "crtex header layout changed");
+
+// True for source extensions the packager converts (png, jpg, jpeg, bmp).
+bool IsConvertible(const std::string &path);
+
+// Encode width x height RGBA rows (pitch bytes apart). With compress the
+// payload is LZ4 when that is actually smaller, raw otherwise.
+void Encode(const std::uint8_t *rgba,
+            int width,
+            int height,
+            int pitch,
+            bool compress,
+            std::vector<std::uint8_t> &out);
+
+// Validate data and read its header. False for anything malformed.
+bool ReadHeader(const std::uint8_t *data,
+                std::size_t size,
+                Header &header);
+
+// Decode into width x height RGBA rows dstPitch bytes apart.
+bool DecodePixels(const std::uint8_t *data,
+                  std::size_t size,
+                  std::uint8_t *dst,
+                  int dstPitch);
+
+// LZ4 block codec. Compress appends to out; Decompress fails unless src
+// expands to exactly dstSize bytes.
+void Lz4Compress(const std::uint8_t *src,
+                 std::size_t size,
+                 std::vector<std::uint8_t> &out);
+bool Lz4Decompress(const std::uint8_t *src,
+                   std::size_t srcSize,
+                   std::uint8_t *dst,
+                   std::size_t dstSize);
+
+}  // namespace cereka::crtex
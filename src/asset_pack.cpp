@@ -0,0 +1,192 @@
+#include "asset_pack.hpp"
+#include "archive/crpak.hpp"
+#include "archive/crtex.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cereka::asset_pack {
+
+namespace {
+
+struct Mapping {
+    const std::uint8_t *data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+Mapping mapped;
+crpak::View view;
+bool mounted = false;
+
+bool mapFile(const std::string &path,
+             Mapping &m)
+{
+#ifdef _WIN32
+    m.file = CreateFileA(path.c_str(),
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         nullptr,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    if (m.file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m.file, &size) || size.QuadPart == 0) {
+        CloseHandle(m.file);
+        m.file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    m.mapping = CreateFileMappingA(m.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m.mapping)
+        m.data = (const std::uint8_t *)MapViewOfFile(m.mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m.data) {
+        if (m.mapping)
+            CloseHandle(m.mapping);
+        CloseHandle(m.file);
+        m = Mapping();
+        return false;
+    }
+    m.size = (std::size_t)size.QuadPart;
+    return true;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file alive
+    if (p == MAP_FAILED)
+        return false;
+    m.data = (const std::uint8_t *)p;
+    m.size = (std::size_t)st.st_size;
+    return true;
+#endif
+}
+
+void unmapFile(Mapping &m)
+{
+    if (!m.data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m.data);
+    CloseHandle(m.mapping);
+    CloseHandle(m.file);
+#else
+    munmap((void *)m.data, m.size);
+#endif
+    m = Mapping();
+}
+
+}  // namespace
+
+bool Mount(const std::string &archivePath)
+{
+    Unmount();
+    if (!mapFile(archivePath, mapped))
+        return false;
+    if (!view.Open(mapped.data, mapped.size)) {
+        std::cerr << "[CEREKA] Ignoring malformed archive: " << archivePath << "\n";
+        unmapFile(mapped);
+        return false;
+    }
+    mounted = true;
+    return true;
+}
+
+void Unmount()
+{
+    mounted = false;
+    view = crpak::View();
+    unmapFile(mapped);
+}
+
+bool Mounted()
+{
+    return mounted;
+}
+
+SDL_IOStream *Open(const std::string &path)
+{
+    if (mounted) {
+        if (const crpak::Entry *e = view.Find(path))
+            return SDL_IOFromConstMem(view.Payload(*e), (size_t)e->size);
+    }
+    return SDL_IOFromFile(path.c_str(), "rb");
+}
+
+bool Exists(const std::string &path)
+{
+    for (const std::string &p : {path, path + crtex::EXTENSION}) {
+        if (mounted && view.Find(p))
+            return true;
+        std::error_code ec;
+        if (fs::is_regular_file(p, ec))
+            return true;
+    }
+    return false;
+}
+
+bool Map(const std::string &path,
+         const std::uint8_t *&data,
+         std::size_t &size)
+{
+    if (!mounted)
+        return false;
+    const crpak::Entry *e = view.Find(path);
+    if (!e)
+        return false;
+    data = view.Payload(*e);
+    size = (std::size_t)e->size;
+    return true;
+}
+
+std::vector<std::string> List(const std::string &dir)
+{
+    std::vector<std::string> out;
+    std::string prefix = dir;
+    if (!prefix.empty() && prefix.back() != '/')
+        prefix += '/';
+
+    if (mounted) {
+        for (const crpak::Entry &e : view) {
+            std::string_view p = view.PathOf(e);
+            if (p.size() > prefix.size() && p.compare(0, prefix.size(), prefix) == 0 &&
+                p.find('/', prefix.size()) == std::string_view::npos)
+                out.emplace_back(p);
+        }
+    }
+
+    size_t packed = out.size();
+    std::error_code ec;
+    for (auto &entry : fs::directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file(ec))
+            continue;
+        std::string p = prefix + entry.path().filename().generic_string();
+        if (std::find(out.begin(), out.begin() + packed, p) == out.begin() + packed)
+            out.push_back(p);
+    }
+    return out;
+}
+
+}  // namespace cereka::asset_pack
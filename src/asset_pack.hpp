@@ -0,0 +1,54 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cereka::asset_pack {
+
+/**
+ * Memory-map a .crpak archive so asset loads are served from it.
+ *
+ * Anything the archive does not contain is still read from loose files, so
+ * an unpacked project keeps working unchanged. Returns false (and stays on
+ * loose files) if the archive is missing or malformed.
+ */
+bool Mount(const std::string &archivePath);
+
+/**
+ * Unmap the archive. Every stream returned by Open must be closed first,
+ * including ones handed to SDL with closeio (fonts, streamed audio).
+ */
+void Unmount();
+
+bool Mounted();
+
+/**
+ * Open an asset by project-relative path ("assets/bg/room.png"): a
+ * zero-copy stream over the mapped archive if it is packed, otherwise the
+ * loose file. Safe to call from worker threads while mounted.
+ * Returns nullptr if neither exists (SDL_GetError set).
+ */
+SDL_IOStream *Open(const std::string &path);
+
+// True if path, or the pre-decoded copy of an image (path + crtex::EXTENSION,
+// which is all a packaged build ships), is packed or exists as a loose file.
+bool Exists(const std::string &path);
+
+/**
+ * Direct view of a packed file's bytes, valid until Unmount. False if no
+ * archive is mounted or it does not contain path (loose files are not
+ * consulted).
+ */
+bool Map(const std::string &path,
+         const std::uint8_t *&data,
+         std::size_t &size);
+
+/**
+ * Files directly inside dir ("assets/fonts"), archive entries first, then
+ * loose files not already listed. Returned paths are project-relative.
+ */
+std::vector<std::string> List(const std::string &dir);
+
+}  // namespace cereka::asset_pack
@@ -0,0 +1,323 @@
+#include "asset_prefetcher.hpp"
+#include "image_loader.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace cereka {
+
+AssetPrefetcher::~AssetPrefetcher()
+{
+    Stop();
+}
+
+void AssetPrefetcher::Start(MIX_Mixer *m,
+                            int workerCount)
+{
+    Stop();
+    mixer = m;
+    stopping = false;
+    for (int i = 0; i < std::max(1, workerCount); ++i)
+        workers.emplace_back([this] { workerLoop(); });
+}
+
+void AssetPrefetcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCv.notify_all();
+    for (auto &t : workers)
+        t.join();
+    workers.clear();
+
+    for (auto &e : entries)
+        release(*e);
+    entries.clear();
+    mixer = nullptr;
+}
+
+void AssetPrefetcher::release(Entry &e)
+{
+    if (e.surface) {
+        SDL_DestroySurface(e.surface);
+        e.surface = nullptr;
+    }
+    if (e.audio.audio) {
+        MIX_DestroyAudio(e.audio.audio);
+        e.audio = {};
+    }
+}
+
+std::vector<std::unique_ptr<AssetPrefetcher::Entry>>::iterator AssetPrefetcher::find(
+    const Request &req)
+{
+    return std::find_if(entries.begin(), entries.end(), [&](const auto &e) {
+        return !e->dropped && e->req == req;
+    });
+}
+
+void AssetPrefetcher::SetWanted(const std::vector<Request> &wanted)
+{
+    if (workers.empty())
+        return;
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Drop everything that fell out of the window.
+        for (auto it = entries.begin(); it != entries.end();) {
+            Entry &e = **it;
+            bool keep = e.held || std::find(wanted.begin(), wanted.end(), e.req) != wanted.end();
+            if (keep) {
+                e.dropped = false;
+                ++it;
+            }
+            else if (e.status == Status::Decoding) {
+                e.dropped = true;  // worker frees it when the decode returns
+                ++it;
+            }
+            else {
+                release(e);
+                it = entries.erase(it);
+            }
+        }
+
+        for (const auto &req : wanted) {
+            if (find(req) != entries.end())
+                continue;
+            auto e = std::make_unique<Entry>();
+            e->req = req;
+            entries.push_back(std::move(e));
+            queued = true;
+        }
+    }
+    if (queued)
+        workCv.notify_all();
+}
+
+std::unique_ptr<AssetPrefetcher::Entry> AssetPrefetcher::takeEntry(
+    const Request &req,
+    std::unique_lock<std::mutex> &lock)
+{
+    auto it = find(req);
+    if (it == entries.end())
+        return nullptr;
+
+    if ((*it)->status == Status::Queued) {
+        // Not started: the caller's synchronous load is no slower than waiting.
+        entries.erase(it);
+        return nullptr;
+    }
+
+    Entry *target = it->get();
+    doneCv.wait(lock, [target] { return target->status != Status::Decoding; });
+
+    it = std::find_if(entries.begin(), entries.end(), [target](const auto &e) {
+        return e.get() == target;
+    });
+    if (it == entries.end())
+        return nullptr;
+    std::unique_ptr<Entry> taken = std::move(*it);
+    entries.erase(it);
+    return taken;
+}
+
+SDL_Surface *AssetPrefetcher::TakeImage(const Request &req)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto e = takeEntry(req, lock);
+    if (!e)
+        return nullptr;
+    SDL_Surface *surf = e->surface;
+    e->surface = nullptr;
+    release(*e);
+    return surf;
+}
+
+audio_loader::Loaded AssetPrefetcher::TakeAudio(const Request &req)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    auto e = takeEntry(req, lock);
+    if (!e)
+        return {};
+    audio_loader::Loaded audio = e->audio;
+    e->audio = {};
+    release(*e);
+    return audio;
+}
+
+bool AssetPrefetcher::Load(const Request &req)
+{
+    if (workers.empty())
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = find(req);
+        if (it != entries.end()) {
+            (*it)->held = true;
+            return true;
+        }
+        // Ahead of the look-ahead entries: workers take queued work in order.
+        auto e = std::make_unique<Entry>();
+        e->req = req;
+        e->held = true;
+        entries.insert(entries.begin(), std::move(e));
+    }
+    workCv.notify_one();
+    return true;
+}
+
+bool AssetPrefetcher::Finished(const Request &req)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = find(req);
+    return it == entries.end() || (*it)->status == Status::Ready ||
+           (*it)->status == Status::Failed;
+}
+
+void AssetPrefetcher::Drop(const Request &req)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = find(req);
+    if (it == entries.end())
+        return;
+    Entry &e = **it;
+    e.held = false;
+    if (e.status == Status::Decoding) {
+        e.dropped = true;
+        return;
+    }
+    release(e);
+    entries.erase(it);
+}
+
+void AssetPrefetcher::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        auto next = entries.end();
+        workCv.wait(lock, [&] {
+            if (stopping)
+                return true;
+            next = std::find_if(entries.begin(), entries.end(), [](const auto &e) {
+                return e->status == Status::Queued;
+            });
+            return next != entries.end();
+        });
+        if (stopping)
+            return;
+
+        Entry *e = next->get();
+        e->status = Status::Decoding;
+        Request req = e->req;
+        lock.unlock();
+
+        SDL_Surface *surface = nullptr;
+        audio_loader::Loaded audio;
+        if (req.kind == Request::Kind::Image)
+            surface = image_loader::LoadSurface(req.path, req.maxW, req.maxH);
+        else if (mixer && req.kind == Request::Kind::Sound)
+            audio = audio_loader::LoadSound(mixer, req.path);
+        else if (mixer)
+            audio = audio_loader::LoadMusic(mixer, req.path, req.predecodeSeconds);
+
+        lock.lock();
+        e->surface = surface;
+        e->audio = audio;
+        e->status = (surface || audio.audio) ? Status::Ready : Status::Failed;
+        if (e->dropped) {
+            release(*e);
+            entries.erase(std::find_if(entries.begin(), entries.end(), [e](const auto &p) {
+                return p.get() == e;
+            }));
+        }
+        doneCv.notify_all();
+    }
+}
+
+std::vector<size_t> AssetPrefetcher::ScanAhead(
+    const std::vector<scenario::Instruction> &program,
+    const std::unordered_map<std::string, size_t> &labels,
+    size_t pc,
+    size_t maxSteps,
+    size_t maxAssets)
+{
+    using scenario::Op;
+
+    std::vector<size_t> hits;
+    std::vector<bool> visited(program.size(), false);
+    std::deque<size_t> paths{pc};
+    size_t steps = 0;
+
+    auto labelPc = [&](const std::string &label) {
+        auto it = labels.find(label);
+        return it != labels.end() ? it->second : program.size();
+    };
+    auto budgetLeft = [&] { return steps < maxSteps && hits.size() < maxAssets; };
+
+    while (!paths.empty() && budgetLeft()) {
+        size_t i = paths.front();
+        paths.pop_front();
+
+        while (i < program.size() && !visited[i] && budgetLeft()) {
+            visited[i] = true;
+            ++steps;
+            const auto &ins = program[i];
+
+            if (ins.op == Op::BG || ins.op == Op::FADE || ins.op == Op::DISSOLVE ||
+                ins.op == Op::CHAR || ins.op == Op::PLAY_BGM || ins.op == Op::PLAY_SFX ||
+                ins.op == Op::PRELOAD_SFX)
+            {
+                hits.push_back(i);
+                ++i;
+            }
+            else if (ins.op == Op::JUMP) {
+                i = labelPc(ins.a);
+            }
+            else if (ins.op == Op::CALL) {
+                // Subroutine first; its RETURN ends the path and the return
+                // point is the next one scanned.
+                paths.push_front(i + 1);
+                i = labelPc(ins.a);
+            }
+            else if (ins.op == Op::MENU) {
+                // Mirror EnterMenu: bg swaps and buttons directly follow MENU.
+                size_t scan = i + 1;
+                bool fallsThrough = false;
+                while (scan < program.size()) {
+                    const auto &m = program[scan];
+                    if (m.op == Op::BG || m.op == Op::FADE || m.op == Op::DISSOLVE)
+                        hits.push_back(scan);
+                    else if (m.op == Op::BUTTON && !m.exit_button) {
+                        if (m.b.empty())
+                            fallsThrough = true;
+                        else
+                            paths.push_back(labelPc(m.b));
+                    }
+                    else if (m.op != Op::BUTTON)
+                        break;
+                    visited[scan] = true;
+                    ++scan;
+                }
+                if (fallsThrough)
+                    paths.push_back(scan);
+                break;
+            }
+            else if (ins.op == Op::RETURN || ins.op == Op::END || ins.op == Op::LOAD) {
+                break;
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    if (hits.size() > maxAssets)
+        hits.resize(maxAssets);
+    return hits;
+}
+
+}  // namespace cereka
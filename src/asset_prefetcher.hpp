@@ -0,0 +1,108 @@
+#pragma once
+
+#include "audio_loader.hpp"
+#include "compiler/vn_instruction.hpp"
+
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cereka {
+
+// Decodes upcoming images and audio on worker threads so the main thread
+// only uploads them when the script reaches the instruction.
+//
+// The engine scans ahead of pc with ScanAhead, turns the asset instructions
+// it finds into Requests and hands the whole window to SetWanted. Loaders
+// then call TakeImage / TakeAudio before falling back to a synchronous load.
+class AssetPrefetcher {
+   public:
+    struct Request {
+        enum class Kind { Image, Sound, Music };
+
+        Kind kind = Kind::Image;
+        std::string path;  // full path as the loader would open it
+        int maxW = 0;      // image fit box (see image_loader::LoadTexture)
+        int maxH = 0;
+        float predecodeSeconds = 0.0f;  // music (see audio_loader::LoadMusic)
+
+        bool operator==(const Request &) const = default;
+    };
+
+    AssetPrefetcher() = default;
+    AssetPrefetcher(const AssetPrefetcher &) = delete;
+    AssetPrefetcher &operator=(const AssetPrefetcher &) = delete;
+    ~AssetPrefetcher();
+
+    // mixer may be null (audio disabled); audio requests then fail fast.
+    void Start(MIX_Mixer *mixer,
+               int workerCount = 2);
+    void Stop();
+
+    // Replace the look-ahead window: queue decodes for new requests and free
+    // results that are no longer ahead of the program counter.
+    void SetWanted(const std::vector<Request> &wanted);
+
+    // Hand over a finished decode (ownership transfers to the caller). Waits
+    // if the decode is already running; returns nullptr / a null audio if it
+    // was never requested, had not started yet, or failed.
+    SDL_Surface *TakeImage(const Request &req);
+    audio_loader::Loaded TakeAudio(const Request &req);
+
+    // Decode req ahead of the look-ahead window and keep it, whatever
+    // SetWanted says, until it is taken or dropped: for a load the caller is
+    // already waiting on. False when no workers are running.
+    bool Load(const Request &req);
+    // True once a Load has finished (or failed), so a Take returns at once.
+    bool Finished(const Request &req);
+    // Abandon a Load. A decode in progress is freed by its worker.
+    void Drop(const Request &req);
+
+    // Indices of asset-loading instructions (BG, FADE, DISSOLVE, CHAR,
+    // PLAY_BGM, PLAY_SFX, PRELOAD_SFX) reachable from pc, nearest first. Follows jumps and
+    // calls and treats every menu button as a possible path. Stops after
+    // visiting maxSteps instructions or collecting maxAssets hits.
+    static std::vector<size_t> ScanAhead(
+        const std::vector<scenario::Instruction> &program,
+        const std::unordered_map<std::string, size_t> &labels,
+        size_t pc,
+        size_t maxSteps = 512,
+        size_t maxAssets = 16);
+
+   private:
+    enum class Status { Queued, Decoding, Ready, Failed };
+
+    struct Entry {
+        Request req;
+        Status status = Status::Queued;
+        bool dropped = false;  // unwanted while decoding; freed by the worker
+        bool held = false;     // requested by Load; outlives the window
+        SDL_Surface *surface = nullptr;
+        audio_loader::Loaded audio;
+    };
+
+    void workerLoop();
+    // Must be called with mutex held. Returns the live entry for req or nullptr.
+    std::vector<std::unique_ptr<Entry>>::iterator find(const Request &req);
+    // Waits for an in-flight decode, then detaches the entry. Mutex held by lock.
+    std::unique_ptr<Entry> takeEntry(const Request &req,
+                                     std::unique_lock<std::mutex> &lock);
+    static void release(Entry &e);
+
+    MIX_Mixer *mixer = nullptr;
+    std::mutex mutex;
+    std::condition_variable workCv;  // workers: queued entry or stop
+    std::condition_variable doneCv;  // takers: a decode finished
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
+
+}  // namespace cereka
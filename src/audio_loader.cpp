@@ -0,0 +1,88 @@
+#include "audio_loader.hpp"
+#include "asset_pack.hpp"
+
+#include <cstdint>
+
+namespace cereka::audio_loader {
+
+namespace {
+
+// Fill in duration and, for predecoded audio, the PCM footprint (the mixer
+// stores decoded samples as 32-bit float).
+void describe(Loaded &l)
+{
+    SDL_AudioSpec spec;
+    Sint64 frames = MIX_GetAudioDuration(l.audio);
+    if (frames <= 0 || !MIX_GetAudioFormat(l.audio, &spec) || spec.freq <= 0)
+        return;
+    l.seconds = (double)frames / spec.freq;
+    if (l.predecoded)
+        l.bytes = (std::size_t)frames * spec.channels * sizeof(float);
+}
+
+Loaded load(MIX_Mixer *mixer,
+            SDL_IOStream *io,
+            bool predecode)
+{
+    Loaded l;
+    if (!io)
+        return l;
+    Sint64 encoded = SDL_GetIOSize(io);
+    l.audio = MIX_LoadAudio_IO(mixer, io, predecode, true);
+    if (!l.audio)
+        return l;
+    l.predecoded = predecode;
+    l.bytes = encoded > 0 ? (std::size_t)encoded : 0;
+    describe(l);
+    return l;
+}
+
+}  // namespace
+
+bool ShouldPredecode(double seconds,
+                     float predecodeSeconds)
+{
+    return seconds > 0.0 && seconds <= predecodeSeconds;
+}
+
+Loaded LoadSound(MIX_Mixer *mixer,
+                 const std::string &path)
+{
+    return load(mixer, asset_pack::Open(path), true);
+}
+
+Loaded LoadMusic(MIX_Mixer *mixer,
+                 const std::string &path,
+                 float predecodeSeconds)
+{
+    // The file is read once: the length probe and a short track's decode
+    // both parse the same bytes (mapped from the archive, or loaded here).
+    const std::uint8_t *data = nullptr;
+    std::size_t size = 0;
+    void *owned = nullptr;
+    if (!asset_pack::Map(path, data, size)) {
+        SDL_IOStream *io = asset_pack::Open(path);
+        if (!io)
+            return {};
+        owned = SDL_LoadFile_IO(io, &size, true);
+        if (!owned)
+            return {};
+        data = (const std::uint8_t *)owned;
+    }
+
+    // Opening without predecoding only reads the header for the length.
+    Loaded l = load(mixer, SDL_IOFromConstMem(data, size), false);
+    if (l.audio && ShouldPredecode(l.seconds, predecodeSeconds)) {
+        // Short loop: trade its small PCM footprint for no decoding while mixing.
+        Loaded pcm = load(mixer, SDL_IOFromConstMem(data, size), true);
+        if (pcm.audio) {
+            MIX_DestroyAudio(l.audio);
+            l = pcm;
+        }
+    }
+    // The mixer keeps its own copy of what it loaded.
+    SDL_free(owned);
+    return l;
+}
+
+}  // namespace cereka::audio_loader
@@ -0,0 +1,43 @@
+#pragma once
+#include <SDL3_mixer/SDL_mixer.h>
+#include <cstddef>
+#include <string>
+
+namespace cereka::audio_loader {
+
+/**
+ * A loaded MIX_Audio plus what it costs to keep resident.
+ */
+struct Loaded {
+    MIX_Audio *audio = nullptr;
+    bool predecoded = false;
+    std::size_t bytes = 0;  // PCM if predecoded, otherwise the encoded file
+    double seconds = 0.0;   // 0 when the decoder cannot tell
+};
+
+/**
+ * Sound effects: decoded to PCM up front so every play starts instantly.
+ * Safe to call from worker threads. Returns a null audio on failure.
+ */
+Loaded LoadSound(MIX_Mixer *mixer,
+                 const std::string &path);
+
+/**
+ * Music: kept in its encoded form and decoded by the mixer while it plays,
+ * so a long track costs its file size rather than minutes of PCM. Tracks no
+ * longer than predecodeSeconds are decoded up front instead. The file is
+ * read once. Looping is sample-accurate either way. Safe to call from
+ * worker threads.
+ */
+Loaded LoadMusic(MIX_Mixer *mixer,
+                 const std::string &path,
+                 float predecodeSeconds);
+
+/**
+ * The choice LoadMusic makes: decode up front only a track whose length is
+ * known and no more than predecodeSeconds.
+ */
+bool ShouldPredecode(double seconds,
+                     float predecodeSeconds);
+
+}  // namespace cereka::audio_loader
@@ -1,6 +1,7 @@
 #include "audio_manager.hpp"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <iostream>
 
 namespace cereka {
@@ -17,6 +18,16 @@ bool AudioManager::Init()
         MIX_Quit();
         return false;
     }
+    for (MIX_Track *&t : bgmTracks) {
+        t = MIX_CreateTrack(mixer);
+        if (!t)
+            std::cerr << "[CEREKA] Failed to create BGM track: " << SDL_GetError() << "\n";
+    }
+    for (Voice &v : voices) {
+        v.track = MIX_CreateTrack(mixer);
+        if (!v.track)
+            std::cerr << "[CEREKA] Failed to create SFX voice: " << SDL_GetError() << "\n";
+    }
     initialized = true;
     return true;
 }
@@ -25,88 +36,288 @@ void AudioManager::Shutdown()
 {
     if (!initialized)
         return;
-    destroyBgmHandles();
-    bgmPath.clear();
-    for (auto &[name, audio] : sfxCache)
-        MIX_DestroyAudio(audio);
+    CancelLoads();
+    StopBGM();
+    for (MIX_Track *&t : bgmTracks) {
+        if (t)
+            MIX_DestroyTrack(t);
+        t = nullptr;
+    }
+    for (Voice &v : voices) {
+        if (v.track)
+            MIX_DestroyTrack(v.track);
+        v = {};
+    }
+    for (auto &[name, sound] : sfxCache)
+        MIX_DestroyAudio(sound.audio);
     sfxCache.clear();
+    sfxLru.Clear();
     MIX_DestroyMixer(mixer);
     mixer = nullptr;
     MIX_Quit();
     initialized = false;
 }
 
-void AudioManager::destroyBgmHandles()
+AssetPrefetcher::Request AudioManager::SoundRequest(const std::string &filename)
 {
-    if (bgmTrack) {
-        MIX_StopTrack(bgmTrack, 0);
-        MIX_DestroyTrack(bgmTrack);
-        bgmTrack = nullptr;
-    }
-    if (bgmAudio) {
-        MIX_DestroyAudio(bgmAudio);
-        bgmAudio = nullptr;
+    return {AssetPrefetcher::Request::Kind::Sound, "assets/sounds/" + filename};
+}
+
+AssetPrefetcher::Request AudioManager::MusicRequest(const std::string &filename) const
+{
+    AssetPrefetcher::Request req = SoundRequest(filename);
+    req.kind = AssetPrefetcher::Request::Kind::Music;
+    req.predecodeSeconds = bgmPredecodeSeconds;
+    return req;
+}
+
+audio_loader::Loaded AudioManager::loadAudio(const AssetPrefetcher::Request &req)
+{
+    if (prefetcher) {
+        audio_loader::Loaded l = prefetcher->TakeAudio(req);
+        if (l.audio)
+            return l;
     }
+    if (req.kind == AssetPrefetcher::Request::Kind::Music)
+        return audio_loader::LoadMusic(mixer, req.path, req.predecodeSeconds);
+    return audio_loader::LoadSound(mixer, req.path);
 }
 
-void AudioManager::PlayBGM(const std::string &filename)
+// ---------------------------------------------------------------------------
+// Background music
+// ---------------------------------------------------------------------------
+
+void AudioManager::PlayBGM(const std::string &filename,
+                           float crossfadeSeconds)
 {
     if (!initialized)
         return;
 
-    destroyBgmHandles();
-    bgmPath = filename;
+    if (filename == bgmPending) {
+        bgmLoadCrossfade = crossfadeSeconds;
+        return;
+    }
+    abandonBgmLoad();
+    AssetPrefetcher::Request req = MusicRequest(filename);
+    if (!prefetcher || !prefetcher->Load(req)) {
+        // No workers to hand it to.
+        startBgm(filename, loadAudio(req), crossfadeSeconds);
+        return;
+    }
+    // A track the look-ahead already decoded is simply kept; Update hands it
+    // over once the worker is done.
+    bgmPending = filename;
+    bgmPendingReq = req;
+    bgmLoadCrossfade = crossfadeSeconds;
+}
 
-    std::string path = "assets/sounds/" + filename;
-    bgmAudio = MIX_LoadAudio(mixer, path.c_str(), true);  // pre-decode for looping
-    if (!bgmAudio) {
-        std::cerr << "[CEREKA] Failed to load BGM: " << path << " — " << SDL_GetError() << "\n";
+void AudioManager::Update()
+{
+    if (!initialized)
         return;
+
+    if (!bgmPending.empty() && prefetcher && prefetcher->Finished(bgmPendingReq)) {
+        std::string filename = std::move(bgmPending);
+        bgmPending.clear();
+        startBgm(filename, prefetcher->TakeAudio(bgmPendingReq), bgmLoadCrossfade);
     }
 
-    bgmTrack = MIX_CreateTrack(mixer);
-    if (!bgmTrack) {
-        std::cerr << "[CEREKA] Failed to create BGM track: " << SDL_GetError() << "\n";
-        MIX_DestroyAudio(bgmAudio);
-        bgmAudio = nullptr;
+    if (bgmOutgoing.audio && !MIX_TrackPlaying(bgmTracks[1 - bgmActive]))
+        releaseOutgoingBgm();
+}
+
+void AudioManager::startBgm(const std::string &filename,
+                            audio_loader::Loaded next,
+                            float crossfadeSeconds)
+{
+    if (!next.audio) {
+        std::cerr << "[CEREKA] Failed to load BGM: " << filename << " — " << SDL_GetError()
+                  << "\n";
         return;
     }
+    std::cerr << "[CEREKA] BGM " << filename << ": "
+              << (next.predecoded ? "pre-decoded" : "streamed") << ", " << next.bytes / 1024
+              << " KB resident, " << (int)next.seconds << " s\n";
+
+    // A third change mid-crossfade cuts the track still fading out.
+    releaseOutgoingBgm();
 
-    MIX_SetTrackAudio(bgmTrack, bgmAudio);
+    int incoming = 1 - bgmActive;
+    MIX_Track *in = bgmTracks[incoming];
+    MIX_Track *out = bgmTracks[bgmActive];
+    if (!in) {
+        MIX_DestroyAudio(next.audio);
+        return;
+    }
+    MIX_SetTrackAudio(in, next.audio);
 
+    Sint64 ms = (Sint64)(std::max(crossfadeSeconds, 0.0f) * 1000.0f);
     SDL_PropertiesID props = SDL_CreateProperties();
     SDL_SetNumberProperty(props, MIX_PROP_PLAY_LOOPS_NUMBER, -1);
-    MIX_PlayTrack(bgmTrack, props);
+    SDL_SetNumberProperty(props, MIX_PROP_PLAY_FADE_IN_FRAMES_NUMBER, MIX_TrackMSToFrames(in, ms));
+
+    // Both ramps are applied per sample by the mixer; holding its lock makes
+    // them begin on the same output frame.
+    MIX_LockMixer(mixer);
+    if (bgm.audio && out)
+        MIX_StopTrack(out, MIX_TrackMSToFrames(out, ms));
+    MIX_PlayTrack(in, props);
+    MIX_UnlockMixer(mixer);
     SDL_DestroyProperties(props);
+
+    bgmOutgoing = bgm;
+    bgm = next;
+    bgmActive = incoming;
+    bgmPath = filename;
+}
+
+void AudioManager::releaseOutgoingBgm()
+{
+    if (!bgmOutgoing.audio)
+        return;
+    MIX_Track *t = bgmTracks[1 - bgmActive];
+    if (t) {
+        MIX_StopTrack(t, 0);
+        MIX_SetTrackAudio(t, nullptr);
+    }
+    MIX_DestroyAudio(bgmOutgoing.audio);
+    bgmOutgoing = {};
+}
+
+void AudioManager::abandonBgmLoad()
+{
+    if (bgmPending.empty())
+        return;
+    // A decode still running is freed by the worker when it returns.
+    if (prefetcher)
+        prefetcher->Drop(bgmPendingReq);
+    bgmPending.clear();
+}
+
+void AudioManager::CancelLoads()
+{
+    abandonBgmLoad();
 }
 
 void AudioManager::StopBGM()
 {
     if (!initialized)
         return;
-    destroyBgmHandles();
+    abandonBgmLoad();
+    releaseOutgoingBgm();
+    if (bgm.audio) {
+        MIX_Track *t = bgmTracks[bgmActive];
+        if (t) {
+            MIX_StopTrack(t, 0);
+            MIX_SetTrackAudio(t, nullptr);
+        }
+        MIX_DestroyAudio(bgm.audio);
+        bgm = {};
+    }
     bgmPath.clear();
 }
 
-void AudioManager::PlaySFX(const std::string &filename)
+void AudioManager::RestoreBGM(const std::string &filename)
 {
-    if (!initialized)
-        return;
+    if (filename.empty())
+        StopBGM();
+    else if (!KeepsBgm(filename, bgm.audio ? bgmPath : std::string(), bgmPending))
+        PlayBGM(filename);
+    else if (filename != bgmPending)
+        abandonBgmLoad();  // keep what plays rather than switch away from it
+}
+
+bool AudioManager::KeepsBgm(const std::string &saved,
+                            const std::string &playing,
+                            const std::string &loading)
+{
+    return !saved.empty() && (saved == playing || saved == loading);
+}
+
+// ---------------------------------------------------------------------------
+// Sound effects
+// ---------------------------------------------------------------------------
 
+AudioManager::SfxCache::value_type *AudioManager::cacheSfx(const std::string &filename)
+{
     auto it = sfxCache.find(filename);
-    if (it == sfxCache.end()) {
-        std::string path = "assets/sounds/" + filename;
-        MIX_Audio *audio = MIX_LoadAudio(mixer, path.c_str(), true);
-        if (!audio) {
-            std::cerr << "[CEREKA] Failed to load SFX: " << path << " — " << SDL_GetError()
-                      << "\n";
-            return;
+    if (it != sfxCache.end()) {
+        sfxLru.Touch(&it->first);
+        return &*it;
+    }
+
+    audio_loader::Loaded sound = loadAudio(SoundRequest(filename));
+    if (!sound.audio) {
+        std::cerr << "[CEREKA] Failed to load SFX: " << filename << " — " << SDL_GetError()
+                  << "\n";
+        return nullptr;
+    }
+    it = sfxCache.emplace(filename, sound).first;
+    sfxLru.Touch(&it->first, sound.bytes);
+    evictSfx();
+    return &*it;
+}
+
+void AudioManager::evictSfx()
+{
+    // The entry just requested is the most recent, so it always survives.
+    for (const std::string *key : sfxLru.TakeOverBudget(sfxBudget)) {
+        for (Voice &v : voices) {
+            if (v.sound == key) {
+                MIX_StopTrack(v.track, 0);
+                MIX_SetTrackAudio(v.track, nullptr);
+                v.sound = nullptr;
+            }
         }
-        sfxCache[filename] = audio;
-        it = sfxCache.find(filename);
+        auto it = sfxCache.find(*key);
+        MIX_DestroyAudio(it->second.audio);
+        sfxCache.erase(it);
+    }
+}
+
+void AudioManager::SetSfxBudget(size_t bytes)
+{
+    sfxBudget = bytes;
+    evictSfx();
+}
+
+AudioManager::Voice *AudioManager::pickVoice(const std::string *sound)
+{
+    std::array<sfx_pool::VoiceState, SFX_VOICES> state;
+    for (size_t i = 0; i < voices.size(); ++i) {
+        const Voice &v = voices[i];
+        state[i] = {v.sound, v.started, v.track && MIX_TrackPlaying(v.track), v.track != nullptr};
     }
+    int i = sfx_pool::PickVoice(state, sound, SFX_MAX_PER_SOUND);
+    return i >= 0 ? &voices[i] : nullptr;
+}
+
+void AudioManager::PreloadSFX(const std::string &filename)
+{
+    if (!initialized)
+        return;
+    cacheSfx(filename);
+}
+
+void AudioManager::PlaySFX(const std::string &filename)
+{
+    if (!initialized)
+        return;
 
-    MIX_PlayAudio(mixer, it->second);  // fire and forget
+    SfxCache::value_type *entry = cacheSfx(filename);
+    if (!entry)
+        return;
+    const std::string *key = &entry->first;
+
+    Voice *v = pickVoice(key);
+    if (!v)
+        return;
+    if (v->sound)
+        MIX_StopTrack(v->track, 0);  // steal
+    MIX_SetTrackAudio(v->track, entry->second.audio);
+    v->sound = key;
+    v->started = ++voiceClock;
+    MIX_PlayTrack(v->track, 0);
 }
 
 }  // namespace cereka
@@ -1,32 +1,113 @@
 #pragma once
 
+#include "asset_prefetcher.hpp"
+#include "sfx_pool.hpp"
+
 #include <SDL3_mixer/SDL_mixer.h>
+#include <array>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cereka {
 
 class AudioManager {
    public:
+    // Sound effects play on a fixed pool of tracks created at Init. One sound
+    // may hold at most SFX_MAX_PER_SOUND voices; past that, or when the pool
+    // is full, the oldest voice is stopped and reused (see sfx_pool).
+    static constexpr int SFX_VOICES = 16;
+    static constexpr int SFX_MAX_PER_SOUND = 4;
+    static constexpr size_t DEFAULT_SFX_BUDGET_BYTES = 32u * 1024u * 1024u;
+
     bool Init();
     void Shutdown();
 
-    void PlayBGM(const std::string &filename);
+    // The track is opened on the prefetcher's workers; the current one keeps
+    // playing until it is ready and then hands over on the same mixer pass,
+    // blending over crossfadeSeconds (0 is a hard cut). A track that fails to
+    // load leaves the current one playing under its own name.
+    void PlayBGM(const std::string &filename,
+                 float crossfadeSeconds = 0.0f);
     void StopBGM();
+    // Make filename the BGM (empty stops it). Music already playing or
+    // loading that file carries on uninterrupted; anything else is a hard cut.
+    void RestoreBGM(const std::string &filename);
+    // RestoreBGM's choice: carry on when the saved track is the one playing
+    // or the one loading (either may be empty).
+    static bool KeepsBgm(const std::string &saved,
+                         const std::string &playing,
+                         const std::string &loading);
+    // Start a BGM whose load has finished and free faded-out tracks. Per frame.
+    void Update();
+    // Discard an in-flight BGM load. It runs on the prefetcher, so this must
+    // run before the prefetcher stops.
+    void CancelLoads();
     void PlaySFX(const std::string &filename);
+    // Decode a sound into the cache now so its first play does no work.
+    void PreloadSFX(const std::string &filename);
+
+    // Loads consult the prefetcher first and fall back to decoding inline.
+    void AttachPrefetcher(AssetPrefetcher *p) { prefetcher = p; }
+    static AssetPrefetcher::Request SoundRequest(const std::string &filename);
+    AssetPrefetcher::Request MusicRequest(const std::string &filename) const;
+    MIX_Mixer *Mixer() const { return mixer; }
+
+    // BGM no longer than this is decoded to PCM up front; longer tracks are
+    // decoded while they play (see audio_loader::LoadMusic).
+    void SetBgmPredecodeSeconds(float seconds) { bgmPredecodeSeconds = seconds; }
+    // Resident cost of the current BGM (null audio when nothing is playing).
+    const audio_loader::Loaded &Bgm() const { return bgm; }
+    bool HasCachedSfx(const std::string &filename) const { return sfxCache.count(filename) > 0; }
 
+    // Decoded SFX are evicted least-recently-played first beyond this size.
+    void SetSfxBudget(size_t bytes);
+    size_t SfxResidentBytes() const { return sfxLru.Resident(); }
+
+    // The track playing; empty when none is.
     const std::string &BgmPath() const { return bgmPath; }
+    // What a save should record: the track loading, else the one playing.
+    const std::string &BgmTarget() const { return bgmPending.empty() ? bgmPath : bgmPending; }
     bool IsInitialized() const { return initialized; }
 
    private:
-    void destroyBgmHandles();
+    struct Voice {
+        MIX_Track *track = nullptr;
+        const std::string *sound = nullptr;  // key in sfxCache; null when idle
+        Uint64 started = 0;
+    };
+
+    void startBgm(const std::string &filename,
+                  audio_loader::Loaded next,
+                  float crossfadeSeconds);
+    void releaseOutgoingBgm();
+    void abandonBgmLoad();
+    using SfxCache = std::unordered_map<std::string, audio_loader::Loaded>;
+
+    SfxCache::value_type *cacheSfx(const std::string &filename);
+    void evictSfx();
+    Voice *pickVoice(const std::string *sound);
+    audio_loader::Loaded loadAudio(const AssetPrefetcher::Request &req);
 
     bool initialized = false;
     MIX_Mixer *mixer = nullptr;
-    MIX_Audio *bgmAudio = nullptr;
-    MIX_Track *bgmTrack = nullptr;
-    std::string bgmPath;  // last filename passed to PlayBGM (for save/load)
-    std::unordered_map<std::string, MIX_Audio *> sfxCache;
+    AssetPrefetcher *prefetcher = nullptr;
+    // BGM alternates between two tracks so the outgoing one can fade out
+    // while the incoming one fades in.
+    std::array<MIX_Track *, 2> bgmTracks = {};
+    int bgmActive = 0;
+    audio_loader::Loaded bgm;          // on bgmTracks[bgmActive]
+    audio_loader::Loaded bgmOutgoing;  // fading out on the other track
+    std::string bgmPending;                  // PlayBGM's track while it loads
+    AssetPrefetcher::Request bgmPendingReq;  // its request to the prefetcher
+    float bgmLoadCrossfade = 0.0f;
+    float bgmPredecodeSeconds = 15.0f;
+    std::string bgmPath;  // filename of bgm, set once it has loaded
+    SfxCache sfxCache;
+    sfx_pool::Lru sfxLru;  // over sfxCache's keys
+    size_t sfxBudget = DEFAULT_SFX_BUDGET_BYTES;
+    std::array<Voice, SFX_VOICES> voices;
+    Uint64 voiceClock = 0;
 };
 
 }  // namespace cereka
@@ -0,0 +1,143 @@
+#include "asset_manifest.hpp"
+#include "asset_pack.hpp"
+
+#include <algorithm>
+
+namespace cereka::scenario {
+
+namespace {
+
+bool assetOf(const Instruction &ins,
+             AssetRef &ref)
+{
+    switch (ins.op) {
+        case Op::BG:
+        case Op::FADE:
+        case Op::DISSOLVE:
+            ref = {AssetRef::Kind::Background, ins.a, "assets/bg/" + ins.a};
+            break;
+        case Op::CHAR:
+            ref = {AssetRef::Kind::Character, ins.b, "assets/characters/" + ins.b};
+            break;
+        case Op::PLAY_BGM:
+            ref = {AssetRef::Kind::Music, ins.a, "assets/sounds/" + ins.a};
+            break;
+        case Op::PLAY_SFX:
+        case Op::PRELOAD_SFX:
+            ref = {AssetRef::Kind::Sound, ins.a, "assets/sounds/" + ins.a};
+            break;
+        default:
+            return false;
+    }
+    ref.srcLine = ins.srcLine;
+    ref.srcFile = ins.srcFile;
+    return !ref.file.empty();
+}
+
+// Control may leave the straight line after these (conditionals skip ahead
+// at runtime, so they split regions too).
+bool endsRegion(Op op)
+{
+    switch (op) {
+        case Op::JUMP:
+        case Op::CALL:
+        case Op::RETURN:
+        case Op::END:
+        case Op::LOAD:
+        case Op::IF_EQ:
+        case Op::IF_NEQ:
+        case Op::IF_GT:
+        case Op::IF_LT:
+        case Op::IF_GE:
+        case Op::IF_LE:
+        case Op::ELSE:
+        case Op::ENDIF:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool menuBody(Op op)
+{
+    return op == Op::BUTTON || op == Op::BG || op == Op::FADE || op == Op::DISSOLVE;
+}
+
+}  // namespace
+
+AssetManifest BuildAssetManifest(const std::vector<Instruction> &program)
+{
+    AssetManifest m;
+    std::unordered_map<std::string, size_t> index;  // path -> assets slot
+
+    auto addAsset = [&](AssetManifest::Region &r, const Instruction &ins) {
+        AssetRef ref;
+        if (!assetOf(ins, ref))
+            return;
+        auto [it, inserted] = index.try_emplace(ref.path, m.assets.size());
+        if (inserted)
+            m.assets.push_back(std::move(ref));
+        if (std::find(r.assets.begin(), r.assets.end(), it->second) == r.assets.end())
+            r.assets.push_back(it->second);
+    };
+
+    size_t i = 0;
+    while (i < program.size()) {
+        AssetManifest::Region r;
+        r.begin = i;
+        while (i < program.size()) {
+            const Instruction &ins = program[i];
+            if (ins.op == Op::LABEL && i != r.begin)
+                break;
+            addAsset(r, ins);
+            ++i;
+            if (ins.op == Op::MENU) {
+                // The menu's own bg swaps and buttons run with it.
+                while (i < program.size() && menuBody(program[i].op))
+                    addAsset(r, program[i++]);
+                break;
+            }
+            if (endsRegion(ins.op))
+                break;
+        }
+        r.end = i;
+        m.regions.push_back(std::move(r));
+    }
+
+    std::vector<size_t> *current = nullptr;
+    for (const AssetManifest::Region &r : m.regions) {
+        if (program[r.begin].op == Op::LABEL)
+            current = &m.labels[program[r.begin].a];
+        if (!current)
+            continue;
+        for (size_t a : r.assets)
+            if (std::find(current->begin(), current->end(), a) == current->end())
+                current->push_back(a);
+    }
+    return m;
+}
+
+const AssetManifest::Region *AssetManifest::RegionAt(size_t pc) const
+{
+    auto it = std::upper_bound(regions.begin(), regions.end(), pc, [](size_t p, const Region &r) {
+        return p < r.end;
+    });
+    return it != regions.end() ? &*it : nullptr;
+}
+
+const std::vector<size_t> *AssetManifest::LabelAssets(const std::string &label) const
+{
+    auto it = labels.find(label);
+    return it != labels.end() ? &it->second : nullptr;
+}
+
+std::vector<const AssetRef *> MissingAssets(const AssetManifest &manifest)
+{
+    std::vector<const AssetRef *> missing;
+    for (const AssetRef &a : manifest.assets)
+        if (!asset_pack::Exists(a.path))
+            missing.push_back(&a);
+    return missing;
+}
+
+}  // namespace cereka::scenario
@@ -0,0 +1,58 @@
+#pragma once
+#include "vn_instruction.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cereka::scenario {
+
+/**
+ * One asset a compiled program refers to.
+ */
+struct AssetRef {
+    enum class Kind { Background, Character, Music, Sound };
+
+    Kind kind = Kind::Background;
+    std::string file;  // as written in the script ("room.png")
+    std::string path;  // project-relative, as the loaders open it ("assets/bg/room.png")
+    int srcLine = 0;   // first use
+    std::size_t srcFile = 0;  // its Instruction::srcFile
+};
+
+/**
+ * Which assets each part of a program needs, worked out from the resolved
+ * instruction list without running it.
+ *
+ * A region is a straight-line run: it starts at pc 0, at a label or after a
+ * jump, call, menu, conditional or end, so every instruction in it runs
+ * once control reaches its first one. A label's set covers every region up
+ * to the next label.
+ */
+struct AssetManifest {
+    struct Region {
+        size_t begin = 0;  // [begin, end) in the program
+        size_t end = 0;
+        std::vector<size_t> assets;  // indices into AssetManifest::assets
+    };
+
+    std::vector<AssetRef> assets;  // distinct, in order of first use
+    std::vector<Region> regions;   // contiguous, in program order
+    std::unordered_map<std::string, std::vector<size_t>> labels;
+
+    // Region containing pc, or nullptr if pc is past the end.
+    const Region *RegionAt(size_t pc) const;
+    // Assets used from label up to the next one; nullptr for unknown labels.
+    const std::vector<size_t> *LabelAssets(const std::string &label) const;
+};
+
+AssetManifest BuildAssetManifest(const std::vector<Instruction> &program);
+
+/**
+ * Assets in the manifest that are neither packed nor on disk. Checked
+ * against the mounted archive (see asset_pack) and the working directory.
+ */
+std::vector<const AssetRef *> MissingAssets(const AssetManifest &manifest);
+
+}  // namespace cereka::scenario
@@ -1,5 +1,8 @@
 #include "vn_instruction.hpp"
+#include "asset_manifest.hpp"
 #include "compiler_lua_embed.hpp"
+#include "config/property_types.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -14,7 +17,8 @@ namespace cereka::scenario {
 // Forward declaration for recursive include/call resolution
 // ---------------------------------------------------------------------------
 static std::vector<Instruction> CompileFile(const fs::path &path,
-                                            int depth);
+                                            int depth,
+                                            CompileCache *cache);
 
 // ---------------------------------------------------------------------------
 // Run compiler.lua on script_text, return raw instruction list
@@ -93,6 +97,8 @@ static std::vector<Instruction> RunLuaCompiler(const std::string &scriptText)
             ins.op = Op::STOP_BGM;
         else if (op == "PLAY_SFX")
             ins.op = Op::PLAY_SFX;
+        else if (op == "PRELOAD_SFX")
+            ins.op = Op::PRELOAD_SFX;
         else if (op == "HIDE_CHAR")
             ins.op = Op::HIDE_CHAR;
         else if (op == "SET_VAR")
@@ -117,6 +123,8 @@ static std::vector<Instruction> RunLuaCompiler(const std::string &scriptText)
             ins.op = Op::ELSE;
         else if (op == "FADE")
             ins.op = Op::FADE;
+        else if (op == "DISSOLVE")
+            ins.op = Op::DISSOLVE;
         else if (op == "INCLUDE")
             ins.op = Op::INCLUDE;
         else if (op == "CALL")
@@ -131,6 +139,10 @@ static std::vector<Instruction> RunLuaCompiler(const std::string &scriptText)
             ins.op = Op::SAVE_MENU;
         else if (op == "LOAD_MENU")
             ins.op = Op::LOAD_MENU;
+        else if (op == "UNLOCK")
+            ins.op = Op::UNLOCK;
+        else if (op == "ENDING")
+            ins.op = Op::ENDING;
         else {
             std::cerr << "[CEREKA] Unknown op: " << op << "\n";
             continue;
@@ -166,7 +178,8 @@ static std::vector<Instruction> RunLuaCompiler(const std::string &scriptText)
 // Resolve INCLUDEs and CALLs recursively, then return a flat instruction list
 // ---------------------------------------------------------------------------
 static std::vector<Instruction> CompileFile(const fs::path &path,
-                                            int depth)
+                                            int depth,
+                                            CompileCache *cache)
 {
     static constexpr int MAX_DEPTH = 32;
     if (depth > MAX_DEPTH) {
@@ -179,10 +192,28 @@ static std::vector<Instruction> CompileFile(const fs::path &path,
         std::cerr << "[CEREKA] Could not open script: " << path << "\n";
         return {};
     }
-    std::stringstream buf;
-    buf << f.rdbuf();
 
-    std::vector<Instruction> raw = RunLuaCompiler(buf.str());
+    std::string key = path.lexically_normal().string();
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path, ec);
+    std::vector<Instruction> raw;
+    if (cache) {
+        if (std::find(cache->sources.begin(), cache->sources.end(), key) == cache->sources.end())
+            cache->sources.push_back(key);
+        auto hit = cache->files.find(key);
+        if (!ec && hit != cache->files.end() && hit->second.mtime == mtime)
+            raw = hit->second.raw;
+    }
+    if (raw.empty()) {
+        std::stringstream buf;
+        buf << f.rdbuf();
+        raw = RunLuaCompiler(buf.str());
+        std::size_t file = std::hash<std::string>{}(key);
+        for (Instruction &ins : raw)
+            ins.srcFile = file;
+        if (cache && !ec && !raw.empty())
+            cache->files[key] = {mtime, raw};
+    }
 
     fs::path dir = path.parent_path();
     std::vector<Instruction> resolved;
@@ -192,7 +223,7 @@ static std::vector<Instruction> CompileFile(const fs::path &path,
     for (auto &ins : raw) {
         if (ins.op == Op::INCLUDE) {
             // Inline the included file — strip its trailing END
-            auto sub = CompileFile(dir / ins.a, depth + 1);
+            auto sub = CompileFile(dir / ins.a, depth + 1, cache);
             if (!sub.empty() && sub.back().op == Op::END)
                 sub.pop_back();
             resolved.insert(resolved.end(), sub.begin(), sub.end());
@@ -208,7 +239,7 @@ static std::vector<Instruction> CompileFile(const fs::path &path,
             resolved.push_back(callIns);
 
             // Compile the subroutine; replace its END with RETURN
-            auto sub = CompileFile(dir / ins.a, depth + 1);
+            auto sub = CompileFile(dir / ins.a, depth + 1, cache);
             if (!sub.empty() && sub.back().op == Op::END)
                 sub.back().op = Op::RETURN;
             else {
@@ -237,9 +268,53 @@ static std::vector<Instruction> CompileFile(const fs::path &path,
 // ---------------------------------------------------------------------------
 // Public entry point
 // ---------------------------------------------------------------------------
-std::vector<Instruction> CompileVNScript(const std::string &filename)
+std::vector<Instruction> CompileVNScript(const std::string &filename,
+                                         CompileCache *cache,
+                                         AssetManifest *manifest)
 {
-    return CompileFile(fs::absolute(filename), 0);
+    // The cache's source list also names the files behind srcFile below.
+    CompileCache local;
+    if (!cache)
+        cache = &local;
+    cache->sources.clear();
+    std::vector<Instruction> program = CompileFile(fs::absolute(filename), 0, cache);
+
+    // "file:line" for diagnostics; line numbers alone are ambiguous once
+    // includes and calls mix files.
+    auto where = [&](std::size_t file, int line) {
+        std::string name = "?";
+        for (const std::string &src : cache->sources) {
+            if (std::hash<std::string>{}(src) == file) {
+                name = fs::path(src).lexically_proximate(fs::current_path()).string();
+                break;
+            }
+        }
+        return name + ":" + std::to_string(line);
+    };
+
+    // ui blocks must parse as typed patches; a bad theme value would
+    // otherwise only show up when the scene that sets it is reached.
+    for (const Instruction &ins : program) {
+        if (ins.op != Op::UI_SET)
+            continue;
+        config::PropertyPatch patch;
+        std::string error;
+        if (!config::compilePatch(ins.a, ins.b, patch, error)) {
+            std::cerr << "[CEREKA] Script compile error: " << where(ins.srcFile, ins.srcLine)
+                      << ": ui " << error << "\n";
+            return {};
+        }
+    }
+
+    // Report typos in asset names now rather than when the scene is reached.
+    // A file that is not drawn yet should not stop the rest from running.
+    AssetManifest built = BuildAssetManifest(program);
+    for (const AssetRef *a : MissingAssets(built))
+        std::cerr << "[CEREKA] Script warning: " << where(a->srcFile, a->srcLine)
+                  << ": missing asset " << a->path << "\n";
+    if (manifest)
+        *manifest = std::move(built);
+    return program;
 }
 
 }  // namespace cereka::scenario
@@ -1,5 +1,7 @@
 #pragma once
+#include <filesystem>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cereka::scenario {
@@ -18,6 +20,7 @@ enum class Op {
     PLAY_BGM,
     STOP_BGM,
     PLAY_SFX,
+    PRELOAD_SFX,
     SET_VAR,
     SET_VAR_NUM,
     IF_EQ,
@@ -29,6 +32,7 @@ enum class Op {
     ENDIF,
     ELSE,
     FADE,
+    DISSOLVE,
     INCLUDE,
     CALL,
     RETURN,
@@ -37,6 +41,8 @@ enum class Op {
     LOAD,
     SAVE_MENU,
     LOAD_MENU,
+    UNLOCK,
+    ENDING,
 };
 
 struct ChoiceOption {
@@ -56,8 +62,32 @@ struct Instruction {
     // (e.g. instructions synthesized by include/call expansion).
     int srcLine = 0;
     int srcCol = 0;
+    // Which file that is, as a hash of its path: line numbers are per file,
+    // and include / call expansion mixes files in one program. 0 = unknown.
+    std::size_t srcFile = 0;
 };
 
-std::vector<Instruction> CompileVNScript(const std::string &filename);
+// compiler.lua output per file, reused while the file is unchanged so a
+// recompile after an edit only runs the compiler on the edited files.
+struct CompileCache {
+    struct File {
+        std::filesystem::file_time_type mtime;
+        std::vector<Instruction> raw;  // before include / call resolution
+    };
+    std::unordered_map<std::string, File> files;
+    // Every script the last compile read: entry, includes and calls.
+    std::vector<std::string> sources;
+};
+
+struct AssetManifest;
+
+// Compile filename with everything it includes and calls. Empty on any
+// error: a compiler failure or a malformed ui value. Assets that are
+// neither packed nor on disk are reported but do not fail the compile. If
+// manifest is given it receives the program's asset manifest, built once
+// here for that check.
+std::vector<Instruction> CompileVNScript(const std::string &filename,
+                                         CompileCache *cache = nullptr,
+                                         AssetManifest *manifest = nullptr);
 
 }  // namespace cereka::scenario
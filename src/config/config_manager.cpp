@@ -1,81 +1,291 @@
 // config_manager.cpp — Data-driven ConfigManager implementation
 //
 // Properties are defined as data in PROPERTY_TABLE.
-// Each property entry contains: key, type, and description.
-// Type handlers and serializers are shared across all properties.
+// Each property entry contains: key, type, description, and the
+// setter / getter that write and read its UiConfig member directly.
+// Parsers and serializers are shared across all properties.
 //
 // To add a new property:
 //   1. Add entry to PROPERTY_TABLE
-//   2. Add case in serialize() if needed
 // ============================================================================
 
 #include "config_manager.hpp"
 #include "property_types.hpp"
 #include <sstream>
+#include <type_traits>
 
 namespace config {
 
 // ============================================================================
-// Property Table — all configurable properties defined as data
+// Member Access — setters and getters generated from member pointers
 // ============================================================================
 //
-// Format: { key, type, description }
-//
-// Type determines:
-//   - How the value is parsed from string
-//   - How the value is serialized to string
-//   - How the value is applied to UiConfig
+// A property names the path to its member, e.g.
+//   &UiConfig::textbox, &UiConfig::Textbox::color
+// and gets a setter that copies the matching ApplyValue field there and a
+// getter that serializes it back.
+// ============================================================================
+
+template <class T>
+const T &valueOf(const ApplyValue &v);
+template <>
+const float &valueOf<float>(const ApplyValue &v)
+{
+    return v.floatVal;
+}
+template <>
+const int &valueOf<int>(const ApplyValue &v)
+{
+    return v.intVal;
+}
+template <>
+const SDL_Color &valueOf<SDL_Color>(const ApplyValue &v)
+{
+    return v.colorVal;
+}
+template <>
+const Dim &valueOf<Dim>(const ApplyValue &v)
+{
+    return v.dimVal;
+}
+template <>
+const std::vector<SDL_Keycode> &valueOf<std::vector<SDL_Keycode>>(const ApplyValue &v)
+{
+    return v.keyListVal;
+}
+
+static std::string serialize(float v)
+{
+    return serializers::serializeFloat(v);
+}
+static std::string serialize(int v)
+{
+    return serializers::serializeInt(v);
+}
+static std::string serialize(const std::string &v)
+{
+    return serializers::serializeTexture(v);
+}
+static std::string serialize(const SDL_Color &v)
+{
+    return serializers::serializeColor(v);
+}
+static std::string serialize(const Dim &v)
+{
+    return serializers::serializeDim(v);
+}
+static std::string serialize(const std::vector<SDL_Keycode> &v)
+{
+    return serializers::serializeKeyList(v);
+}
+
+template <auto... Path>
+void setField(ApplyContext &ctx,
+              const ApplyValue &v)
+{
+    auto &field = (*ctx.uiCfg .* ... .* Path);
+    field = valueOf<std::remove_cvref_t<decltype(field)>>(v);
+}
+
+template <auto... Path>
+std::string getField(const UiConfig &cfg)
+{
+    return serialize((cfg .* ... .* Path));
+}
+
+// Texture members pair a path with the loaded texture. A patch compiled
+// ahead of time carries the texture already loaded; otherwise load now.
+template <auto Group, auto Tex, auto Path>
+void setTexture(ApplyContext &ctx,
+                const ApplyValue &v)
+{
+    auto &group = ctx.uiCfg->*Group;
+    group.*Path = v.stringVal;
+    if (v.texture && ctx.assignTexture)
+        ctx.assignTexture(group.*Tex, v.texture);
+    else if (ctx.loadTexture)
+        ctx.loadTexture(group.*Tex, v.stringVal);
+}
+
+#define FIELD(...) setField<__VA_ARGS__>, getField<__VA_ARGS__>
+#define TEXTURE(group, tex, path) setTexture<group, tex, path>, getField<group, path>
+
+// ============================================================================
+// Property Table — all configurable properties defined as data
+// ============================================================================
 //
-// For simple types (Float, Int, String, Bool):
-//   Handler is defined in the APPLY_TO_UI_CFG macro below.
+// Format: { key, type, description, setter, getter }
 //
-// For complex types (Color, Dim, Texture):
-//   Handler explicitly defined below.
+// Type determines how the value is parsed from string; the setter writes
+// the parsed value into UiConfig (plus any side effect), the getter
+// serializes the current member.
 // ============================================================================
 
 static const PropertyDef PROPERTY_TABLE[] = {
     // ------------------------------------------------------------------------
     // Textbox properties
     // ------------------------------------------------------------------------
-    {"textbox.image", PropType::Texture, "Textbox background image path"},
-    {"textbox.color", PropType::Color, "Textbox background color (r g b a)"},
-    {"textbox.y", PropType::Dim, "Textbox Y position (pixels or percentage%)"},
-    {"textbox.h", PropType::Dim, "Textbox height (pixels or percentage%)"},
-    {"textbox.text_margin_x", PropType::Float, "Text horizontal margin inside textbox"},
-    {"textbox.text_color", PropType::Color, "Text color (r g b a)"},
+    {"textbox.image",
+     PropType::Texture,
+     "Textbox background image path",
+     TEXTURE(&UiConfig::textbox, &UiConfig::Textbox::image, &UiConfig::Textbox::imagePath)},
+    {"textbox.color",
+     PropType::Color,
+     "Textbox background color (r g b a)",
+     FIELD(&UiConfig::textbox, &UiConfig::Textbox::color)},
+    {"textbox.y",
+     PropType::Dim,
+     "Textbox Y position (pixels or percentage%)",
+     FIELD(&UiConfig::textbox, &UiConfig::Textbox::y)},
+    {"textbox.h",
+     PropType::Dim,
+     "Textbox height (pixels or percentage%)",
+     FIELD(&UiConfig::textbox, &UiConfig::Textbox::h)},
+    {"textbox.text_margin_x",
+     PropType::Float,
+     "Text horizontal margin inside textbox",
+     FIELD(&UiConfig::textbox, &UiConfig::Textbox::textMarginX)},
+    {"textbox.text_color",
+     PropType::Color,
+     "Text color (r g b a)",
+     FIELD(&UiConfig::textbox, &UiConfig::Textbox::textColor)},
 
     // ------------------------------------------------------------------------
     // Namebox properties
     // ------------------------------------------------------------------------
-    {"namebox.image", PropType::Texture, "Namebox background image path"},
-    {"namebox.color", PropType::Color, "Namebox background color (r g b a)"},
-    {"namebox.x", PropType::Float, "Namebox X position (pixels from left)"},
-    {"namebox.y_offset", PropType::Float, "Namebox Y offset from textbox top"},
-    {"namebox.w", PropType::Float, "Namebox width"},
-    {"namebox.h", PropType::Float, "Namebox height"},
-    {"namebox.text_color", PropType::Color, "Name text color (r g b a)"},
+    {"namebox.image",
+     PropType::Texture,
+     "Namebox background image path",
+     TEXTURE(&UiConfig::namebox, &UiConfig::Namebox::image, &UiConfig::Namebox::imagePath)},
+    {"namebox.color",
+     PropType::Color,
+     "Namebox background color (r g b a)",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::color)},
+    {"namebox.x",
+     PropType::Float,
+     "Namebox X position (pixels from left)",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::x)},
+    {"namebox.y_offset",
+     PropType::Float,
+     "Namebox Y offset from textbox top",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::yOffset)},
+    {"namebox.w",
+     PropType::Float,
+     "Namebox width",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::w)},
+    {"namebox.h",
+     PropType::Float,
+     "Namebox height",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::h)},
+    {"namebox.text_color",
+     PropType::Color,
+     "Name text color (r g b a)",
+     FIELD(&UiConfig::namebox, &UiConfig::Namebox::textColor)},
 
     // ------------------------------------------------------------------------
     // Button properties
     // ------------------------------------------------------------------------
-    {"button.image", PropType::Texture, "Button background image path"},
-    {"button.hover_image", PropType::Texture, "Button hover image path"},
-    {"button.color", PropType::Color, "Button background color (r g b a)"},
-    {"button.w", PropType::Float, "Button width"},
-    {"button.h", PropType::Float, "Button height"},
-    {"button.text_color", PropType::Color, "Button text color (r g b a)"},
+    {"button.image",
+     PropType::Texture,
+     "Button background image path",
+     TEXTURE(&UiConfig::button, &UiConfig::Button::image, &UiConfig::Button::imagePath)},
+    {"button.hover_image",
+     PropType::Texture,
+     "Button hover image path",
+     TEXTURE(&UiConfig::button,
+             &UiConfig::Button::hoverImage,
+             &UiConfig::Button::hoverImagePath)},
+    {"button.color",
+     PropType::Color,
+     "Button background color (r g b a)",
+     FIELD(&UiConfig::button, &UiConfig::Button::color)},
+    {"button.w",
+     PropType::Float,
+     "Button width",
+     FIELD(&UiConfig::button, &UiConfig::Button::w)},
+    {"button.h",
+     PropType::Float,
+     "Button height",
+     FIELD(&UiConfig::button, &UiConfig::Button::h)},
+    {"button.text_color",
+     PropType::Color,
+     "Button text color (r g b a)",
+     FIELD(&UiConfig::button, &UiConfig::Button::textColor)},
 
     // ------------------------------------------------------------------------
     // Font properties
     // ------------------------------------------------------------------------
-    {"font.size", PropType::Int, "Font size in pixels"},
+    {"font.size",
+     PropType::Int,
+     "Font size in pixels",
+     [](ApplyContext &ctx, const ApplyValue &v) {
+         if (v.intVal == ctx.uiCfg->fontSize)
+             return;
+         ctx.uiCfg->fontSize = v.intVal;
+         if (ctx.reloadFont)
+             ctx.reloadFont(v.intVal);
+     },
+     getField<&UiConfig::fontSize>},
+
+    // ------------------------------------------------------------------------
+    // Overlay backdrop properties
+    // ------------------------------------------------------------------------
+    {"overlay.dim",
+     PropType::Int,
+     "Darkening of the scene behind save / load overlays (0-255)",
+     FIELD(&UiConfig::overlay, &UiConfig::Overlay::dim)},
+    {"overlay.blur",
+     PropType::Int,
+     "Blur of the scene behind save / load overlays (0 = none, up to 4)",
+     FIELD(&UiConfig::overlay, &UiConfig::Overlay::blur)},
+
+    // ------------------------------------------------------------------------
+    // Texture cache properties
+    // ------------------------------------------------------------------------
+    {"textures.budget_mb",
+     PropType::Int,
+     "VRAM budget for cached textures in megabytes",
+     [](ApplyContext &ctx, const ApplyValue &v) {
+         ctx.uiCfg->textureBudgetMb = v.intVal;
+         if (ctx.setTextureBudget)
+             ctx.setTextureBudget(v.intVal);
+     },
+     getField<&UiConfig::textureBudgetMb>},
+
+    // ------------------------------------------------------------------------
+    // Audio properties
+    // ------------------------------------------------------------------------
+    {"audio.bgm_predecode_seconds",
+     PropType::Float,
+     "BGM up to this many seconds is pre-decoded",
+     [](ApplyContext &ctx, const ApplyValue &v) {
+         ctx.uiCfg->bgmPredecodeSeconds = v.floatVal;
+         if (ctx.setBgmPredecodeSeconds)
+             ctx.setBgmPredecodeSeconds(v.floatVal);
+     },
+     getField<&UiConfig::bgmPredecodeSeconds>},
+    {"audio.sfx_budget_mb",
+     PropType::Int,
+     "Memory budget for decoded sound effects in megabytes",
+     [](ApplyContext &ctx, const ApplyValue &v) {
+         ctx.uiCfg->sfxBudgetMb = v.intVal;
+         if (ctx.setSfxBudget)
+             ctx.setSfxBudget(v.intVal);
+     },
+     getField<&UiConfig::sfxBudgetMb>},
 
     // ------------------------------------------------------------------------
     // Interaction properties
     // ------------------------------------------------------------------------
-    {"advance_keys", PropType::KeyList, "Keys that advance dialogue (space enter click)"},
+    {"advance_keys",
+     PropType::KeyList,
+     "Keys and mouse buttons that advance dialogue (space enter mouse1)",
+     FIELD(&UiConfig::advanceKeys)},
 };
 
+#undef FIELD
+#undef TEXTURE
+
 static constexpr size_t PROPERTY_TABLE_SIZE = sizeof(PROPERTY_TABLE) / sizeof(PROPERTY_TABLE[0]);
 
 // ============================================================================
@@ -95,6 +305,58 @@ struct PropertyLookup {
 
 static PropertyLookup LOOKUP;
 
+static const PropertyDef *findProperty(const std::string &key)
+{
+    auto it = LOOKUP.byKey.find(key);
+    return (it != LOOKUP.byKey.end()) ? it->second : nullptr;
+}
+
+// ============================================================================
+// Patch Compilation — key lookup and parsing done once, ahead of time
+// ============================================================================
+
+static std::string expectedForm(PropType type)
+{
+    switch (type) {
+        case PropType::Float:
+            return "a number";
+        case PropType::Int:
+            return "an integer";
+        case PropType::Bool:
+            return "true or false";
+        case PropType::Color:
+            return "'r g b [a]' with components 0-255";
+        case PropType::Dim:
+            return "pixels or a percentage";
+        case PropType::KeyList:
+            return "key names (" + keyNames() + ")";
+        case PropType::String:
+        case PropType::Texture:
+            break;
+    }
+    return "a value";
+}
+
+bool compilePatch(const std::string &key,
+                  const std::string &value,
+                  PropertyPatch &out,
+                  std::string &error)
+{
+    const PropertyDef *def = findProperty(key);
+    if (!def) {
+        error = "unknown property '" + key + "'";
+        return false;
+    }
+    ApplyValue parsed = parseByType(def->type, value);
+    if (!parsed.ok) {
+        error = key + ": expected " + expectedForm(def->type) + ", got '" + value + "'";
+        return false;
+    }
+    out.def = def;
+    out.value = std::move(parsed);
+    return true;
+}
+
 // ============================================================================
 // PropertyValue Implementation
 // ============================================================================
@@ -153,176 +415,33 @@ void ConfigManager::initDefaults()
 
 const PropertyDef *ConfigManager::getDef(const std::string &key) const
 {
-    auto it = LOOKUP.byKey.find(key);
-    return (it != LOOKUP.byKey.end()) ? it->second : nullptr;
+    return findProperty(key);
 }
 
 std::string ConfigManager::getValue(const std::string &key) const
 {
-    if (!ctx_.uiCfg)
+    const PropertyDef *def = findProperty(key);
+    if (!def || !ctx_.uiCfg)
         return "";
+    return def->get(*ctx_.uiCfg);
+}
 
-    // Helper to serialize Dim
-    auto serializeDim = [](const Dim &d) -> std::string {
-        if (d.relative) {
-            float pct = d.value * 100.0f;
-            int rounded = static_cast<int>(pct + 0.5f);
-            if (pct >= rounded - 0.001f && pct <= rounded + 0.001f) {
-                return std::to_string(rounded) + "%";
-            }
-            return std::to_string(pct) + "%";
-        }
-        return std::to_string(d.value);
-    };
-
-    // Branch only for serialization (reads current values)
-    if (key == "textbox.image")
-        return ctx_.uiCfg->textbox.imagePath;
-    if (key == "textbox.color")
-        return serializers::serializeColor(ctx_.uiCfg->textbox.color);
-    if (key == "textbox.y")
-        return serializeDim(ctx_.uiCfg->textbox.y);
-    if (key == "textbox.h")
-        return serializeDim(ctx_.uiCfg->textbox.h);
-    if (key == "textbox.text_margin_x")
-        return serializers::serializeFloat(ctx_.uiCfg->textbox.textMarginX);
-    if (key == "textbox.text_color")
-        return serializers::serializeColor(ctx_.uiCfg->textbox.textColor);
-
-    if (key == "namebox.image")
-        return ctx_.uiCfg->namebox.imagePath;
-    if (key == "namebox.color")
-        return serializers::serializeColor(ctx_.uiCfg->namebox.color);
-    if (key == "namebox.x")
-        return serializers::serializeFloat(ctx_.uiCfg->namebox.x);
-    if (key == "namebox.y_offset")
-        return serializers::serializeFloat(ctx_.uiCfg->namebox.yOffset);
-    if (key == "namebox.w")
-        return serializers::serializeFloat(ctx_.uiCfg->namebox.w);
-    if (key == "namebox.h")
-        return serializers::serializeFloat(ctx_.uiCfg->namebox.h);
-    if (key == "namebox.text_color")
-        return serializers::serializeColor(ctx_.uiCfg->namebox.textColor);
-
-    if (key == "button.image")
-        return ctx_.uiCfg->button.imagePath;
-    if (key == "button.hover_image")
-        return ctx_.uiCfg->button.hoverImagePath;
-    if (key == "button.color")
-        return serializers::serializeColor(ctx_.uiCfg->button.color);
-    if (key == "button.w")
-        return serializers::serializeFloat(ctx_.uiCfg->button.w);
-    if (key == "button.h")
-        return serializers::serializeFloat(ctx_.uiCfg->button.h);
-    if (key == "button.text_color")
-        return serializers::serializeColor(ctx_.uiCfg->button.textColor);
-
-    if (key == "font.size")
-        return serializers::serializeInt(ctx_.uiCfg->fontSize);
-
-    if (key == "advance_keys")
-        return serializers::serializeKeyList(ctx_.uiCfg->advanceKeys);
-
-    return "";
+void ConfigManager::apply(const PropertyPatch &patch)
+{
+    if (patch.def && ctx_.uiCfg)
+        patch.def->apply(ctx_, patch.value);
 }
 
 void ConfigManager::apply(const std::string &key,
                           const std::string &value)
 {
-    const PropertyDef *def = getDef(key);
-    if (!def) {
-        std::cerr << "[CONFIG] Unknown property: " << key << "\n";
+    PropertyPatch patch;
+    std::string error;
+    if (!compilePatch(key, value, patch, error)) {
+        std::cerr << "[CONFIG] " << error << "\n";
         return;
     }
-
-    // Parse value based on type
-    ApplyValue parsed = parseByType(def->type, value);
-
-    // Apply based on specific property
-    // Note: Each property has specific target in UiConfig
-
-    // ---- Textbox ----
-    if (key == "textbox.image") {
-        handlers::applyTexture(
-            ctx_, parsed, ctx_.uiCfg->textbox.image, ctx_.uiCfg->textbox.imagePath);
-    }
-    else if (key == "textbox.color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->textbox.color);
-    }
-    else if (key == "textbox.y") {
-        handlers::applyDim(ctx_, parsed, &ctx_.uiCfg->textbox.y);
-    }
-    else if (key == "textbox.h") {
-        handlers::applyDim(ctx_, parsed, &ctx_.uiCfg->textbox.h);
-    }
-    else if (key == "textbox.text_margin_x") {
-        ctx_.uiCfg->textbox.textMarginX = parsed.floatVal;
-    }
-    else if (key == "textbox.text_color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->textbox.textColor);
-    }
-
-    // ---- Namebox ----
-    else if (key == "namebox.image") {
-        handlers::applyTexture(
-            ctx_, parsed, ctx_.uiCfg->namebox.image, ctx_.uiCfg->namebox.imagePath);
-    }
-    else if (key == "namebox.color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->namebox.color);
-    }
-    else if (key == "namebox.x") {
-        ctx_.uiCfg->namebox.x = parsed.floatVal;
-    }
-    else if (key == "namebox.y_offset") {
-        ctx_.uiCfg->namebox.yOffset = parsed.floatVal;
-    }
-    else if (key == "namebox.w") {
-        ctx_.uiCfg->namebox.w = parsed.floatVal;
-    }
-    else if (key == "namebox.h") {
-        ctx_.uiCfg->namebox.h = parsed.floatVal;
-    }
-    else if (key == "namebox.text_color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->namebox.textColor);
-    }
-
-    // ---- Button ----
-    else if (key == "button.image") {
-        handlers::applyTexture(
-            ctx_, parsed, ctx_.uiCfg->button.image, ctx_.uiCfg->button.imagePath);
-    }
-    else if (key == "button.hover_image") {
-        handlers::applyTexture(
-            ctx_, parsed, ctx_.uiCfg->button.hoverImage, ctx_.uiCfg->button.hoverImagePath);
-    }
-    else if (key == "button.color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->button.color);
-    }
-    else if (key == "button.w") {
-        ctx_.uiCfg->button.w = parsed.floatVal;
-    }
-    else if (key == "button.h") {
-        ctx_.uiCfg->button.h = parsed.floatVal;
-    }
-    else if (key == "button.text_color") {
-        handlers::applyColor(ctx_, parsed, &ctx_.uiCfg->button.textColor);
-    }
-
-    // ---- Font ----
-    else if (key == "font.size") {
-        int newSize = parsed.intVal;
-        if (newSize != ctx_.uiCfg->fontSize) {
-            ctx_.uiCfg->fontSize = newSize;
-            if (ctx_.reloadFont) {
-                ctx_.reloadFont(newSize);
-            }
-        }
-    }
-
-    // ---- Interaction ----
-    else if (key == "advance_keys") {
-        handlers::applyKeyList(ctx_, parsed);
-    }
+    apply(patch);
 }
 
 std::vector<std::string> ConfigManager::listProperties() const
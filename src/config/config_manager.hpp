@@ -4,7 +4,8 @@
 // Enterprise-grade config system with Property Map Pattern.
 //
 // Key concepts:
-//   PropertyDef   - Static definition of a property (name, type, description)
+//   PropertyDef   - Static definition of a property (name, type, setter, getter)
+//   PropertyPatch - A property plus its parsed value, ready to apply
 //   PropertyValue - Runtime value of a property
 //   ApplyContext  - Engine state needed to apply properties
 //
@@ -59,10 +60,13 @@ class ConfigManager {
     // Initialize all known properties from property table
     void initDefaults();
 
-    // Apply a property value by key
+    // Apply a property value by key (parsed on every call)
     void apply(const std::string &key,
                const std::string &value);
 
+    // Apply a compiled patch: a direct member write
+    void apply(const PropertyPatch &patch);
+
     // Get property definition
     const PropertyDef *getDef(const std::string &key) const;
 
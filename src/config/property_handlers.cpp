@@ -1,11 +1,12 @@
-// property_handlers.cpp — Type parsers, serializers, and handlers
+// property_handlers.cpp — Type parsers and serializers
 //
-// Each type has a parser (string → typed value),
-// a serializer (typed value → string),
-// and a handler (apply typed value to target).
+// Each type has a parser (string → typed value)
+// and a serializer (typed value → string).
+// Applying a value is per property (see PROPERTY_TABLE).
 
 #include "property_types.hpp"
-#include <cstdio>
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 
 namespace config {
@@ -29,10 +30,58 @@ static const KeyMapping KEY_MAP[] = {
     {"down", SDLK_DOWN},
     {"left", SDLK_LEFT},
     {"right", SDLK_RIGHT},
+    {"mouse1", MouseKey(SDL_BUTTON_LEFT)},
+    {"mouse2", MouseKey(SDL_BUTTON_MIDDLE)},
+    {"mouse3", MouseKey(SDL_BUTTON_RIGHT)},
 };
 
 static constexpr size_t KEY_MAP_COUNT = sizeof(KEY_MAP) / sizeof(KEY_MAP[0]);
 
+const std::string &keyNames()
+{
+    static const std::string names = [] {
+        std::string out;
+        for (const KeyMapping &k : KEY_MAP)
+            out += (out.empty() ? "" : " ") + std::string(k.name);
+        return out;
+    }();
+    return names;
+}
+
+// ============================================================================
+// Strict Number Parsing — the whole string must be the number
+// ============================================================================
+
+static std::string trim(const std::string &str)
+{
+    size_t first = str.find_first_not_of(" \t");
+    if (first == std::string::npos)
+        return "";
+    size_t last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+static bool toFloat(const std::string &str,
+                    float &out)
+{
+    if (str.empty())
+        return false;
+    char *end = nullptr;
+    out = std::strtof(str.c_str(), &end);
+    return end == str.c_str() + str.size() && std::isfinite(out);
+}
+
+static bool toInt(const std::string &str,
+                  int &out)
+{
+    if (str.empty())
+        return false;
+    char *end = nullptr;
+    long n = std::strtol(str.c_str(), &end, 10);
+    out = (int)n;
+    return end == str.c_str() + str.size() && n == out;
+}
+
 // ============================================================================
 // Type Parsers
 // ============================================================================
@@ -44,7 +93,7 @@ ApplyValue parseFloat(const std::string &str)
     ApplyValue v;
     v.type = PropType::Float;
     v.raw = str;
-    v.floatVal = std::stof(str);
+    v.ok = toFloat(trim(str), v.floatVal);
     return v;
 }
 
@@ -53,7 +102,7 @@ ApplyValue parseInt(const std::string &str)
     ApplyValue v;
     v.type = PropType::Int;
     v.raw = str;
-    v.intVal = std::stoi(str);
+    v.ok = toInt(trim(str), v.intVal);
     return v;
 }
 
@@ -71,28 +120,50 @@ ApplyValue parseBool(const std::string &str)
     ApplyValue v;
     v.type = PropType::Bool;
     v.raw = str;
-    v.boolVal = (str == "true" || str == "1" || str == "yes");
+    std::string t = trim(str);
+    v.boolVal = (t == "true" || t == "1" || t == "yes");
+    v.ok = v.boolVal || t == "false" || t == "0" || t == "no";
     return v;
 }
 
+// "r g b" or "r g b a", each 0-255
 ApplyValue parseColor(const std::string &str)
 {
     ApplyValue v;
     v.type = PropType::Color;
     v.raw = str;
 
-    int r = 255, g = 255, b = 255, a = 255;
-    std::sscanf(str.c_str(), "%d %d %d %d", &r, &g, &b, &a);
-    v.colorVal = {(Uint8)r, (Uint8)g, (Uint8)b, (Uint8)a};
+    std::istringstream iss(str);
+    std::string token;
+    int c[4] = {255, 255, 255, 255};
+    int n = 0;
+    while (iss >> token) {
+        if (n == 4 || !toInt(token, c[n]) || c[n] < 0 || c[n] > 255) {
+            v.ok = false;
+            return v;
+        }
+        ++n;
+    }
+    v.ok = n >= 3;
+    v.colorVal = {(Uint8)c[0], (Uint8)c[1], (Uint8)c[2], (Uint8)c[3]};
     return v;
 }
 
+// "540" (pixels) or "75%"
 ApplyValue parseDim(const std::string &str)
 {
     ApplyValue v;
     v.type = PropType::Dim;
     v.raw = str;
-    v.dimVal = Dim::parse(str);
+
+    std::string t = trim(str);
+    bool relative = !t.empty() && t.back() == '%';
+    if (relative)
+        t.pop_back();
+    float value = 0.0f;
+    v.ok = toFloat(t, value);
+    v.dimVal.value = relative ? value / 100.0f : value;
+    v.dimVal.relative = relative;
     return v;
 }
 
@@ -106,12 +177,14 @@ ApplyValue parseKeyList(const std::string &str)
     std::string token;
 
     while (iss >> token) {
-        for (size_t i = 0; i < KEY_MAP_COUNT; ++i) {
-            if (token == KEY_MAP[i].name) {
-                v.keyListVal.push_back(KEY_MAP[i].code);
-                break;
-            }
+        size_t i = 0;
+        while (i < KEY_MAP_COUNT && token != KEY_MAP[i].name)
+            ++i;
+        if (i == KEY_MAP_COUNT) {
+            v.ok = false;
+            continue;
         }
+        v.keyListVal.push_back(KEY_MAP[i].code);
     }
     return v;
 }
@@ -121,7 +194,7 @@ ApplyValue parseTexture(const std::string &str)
     ApplyValue v;
     v.type = PropType::Texture;
     v.raw = str;
-    v.stringVal = str;
+    v.stringVal = trim(str);
     return v;
 }
 
@@ -178,8 +251,9 @@ std::string serializeDim(const Dim &val)
 {
     if (val.relative) {
         float pct = val.value * 100.0f;
-        if (pct == static_cast<int>(pct)) {
-            return std::to_string(static_cast<int>(pct)) + "%";
+        int rounded = static_cast<int>(std::lround(pct));
+        if (std::fabs(pct - rounded) <= 0.001f) {
+            return std::to_string(rounded) + "%";
         }
         return std::to_string(pct) + "%";
     }
@@ -204,88 +278,6 @@ std::string serializeTexture(const std::string &path)
 
 }  // namespace serializers
 
-// ============================================================================
-// Type Handlers — apply typed value to target
-// ============================================================================
-
-namespace handlers {
-
-void applyFloat(ApplyContext &ctx,
-                ApplyValue &val)
-{
-    (void)ctx;
-    (void)val;
-    // Float properties need target pointer (handled at property level)
-}
-
-void applyInt(ApplyContext &ctx,
-              ApplyValue &val)
-{
-    (void)ctx;
-    (void)val;
-    // Int properties need target pointer (handled at property level)
-}
-
-void applyString(ApplyContext &ctx,
-                 ApplyValue &val)
-{
-    (void)ctx;
-    (void)val;
-    // String properties need target pointer (handled at property level)
-}
-
-void applyBool(ApplyContext &ctx,
-               ApplyValue &val)
-{
-    (void)ctx;
-    (void)val;
-    // Bool properties need target pointer (handled at property level)
-}
-
-void applyColor(ApplyContext &ctx,
-                ApplyValue &val,
-                SDL_Color *target)
-{
-    if (target) {
-        *target = val.colorVal;
-    }
-}
-
-void applyDim(ApplyContext &ctx,
-              ApplyValue &val,
-              Dim *target)
-{
-    (void)ctx;
-    if (target) {
-        *target = val.dimVal;
-    }
-}
-
-void applyKeyList(ApplyContext &ctx,
-                  ApplyValue &val)
-{
-    if (ctx.uiCfg) {
-        ctx.uiCfg->advanceKeys = val.keyListVal;
-    }
-}
-
-void applyTexture(ApplyContext &ctx,
-                  ApplyValue &val,
-                  SDL_Texture *&targetTex,
-                  std::string &targetPath)
-{
-    if (!ctx.loadTexture)
-        return;
-
-    // Update path
-    targetPath = val.stringVal;
-
-    // Load new texture
-    ctx.loadTexture(targetTex, val.stringVal);
-}
-
-}  // namespace handlers
-
 // ============================================================================
 // Property Parse Dispatch — select parser based on type
 // ============================================================================
@@ -2,7 +2,7 @@
 // property_types.hpp — Type definitions for the property system
 //
 // Data-driven configuration: properties are defined as data, not code.
-// Type handlers provide the logic for each property type.
+// Parsers and serializers provide the logic for each property type.
 
 #include "ui_config.hpp"
 #include <functional>
@@ -31,16 +31,6 @@ enum class PropType {
     Texture,  // SDL_Texture* (loaded from path)
 };
 
-// ============================================================================
-// Property Definition — describes a single configurable property
-// ============================================================================
-
-struct PropertyDef {
-    const char *key;          // Property name (e.g., "textbox.color")
-    PropType type;            // Type of the property
-    const char *description;  // Human-readable description
-};
-
 // ============================================================================
 // Apply Context — provides access to engine state for property application
 // ============================================================================
@@ -57,7 +47,11 @@ struct ApplyContext {
     // Callbacks for side effects
     std::function<void(int size)> reloadFont;
     std::function<void(SDL_Texture *&tex, const std::string &path)> loadTexture;
-    std::function<void(SDL_Texture *&tex)> destroyTexture;
+    // Point tex at an already loaded texture (a pre-resolved patch value).
+    std::function<void(SDL_Texture *&tex, SDL_Texture *loaded)> assignTexture;
+    std::function<void(int megabytes)> setTextureBudget;
+    std::function<void(float seconds)> setBgmPredecodeSeconds;
+    std::function<void(int megabytes)> setSfxBudget;
 };
 
 // ============================================================================
@@ -67,6 +61,7 @@ struct ApplyContext {
 struct ApplyValue {
     PropType type;
     std::string raw;  // Raw string value
+    bool ok = true;   // false if raw is not a valid value of type
 
     // Parsed values (only one is valid based on type)
     float floatVal = 0.0f;
@@ -76,15 +71,55 @@ struct ApplyValue {
     SDL_Color colorVal = {255, 255, 255, 255};
     Dim dimVal;
     std::vector<SDL_Keycode> keyListVal;
+    SDL_Texture *texture = nullptr;  // Texture value loaded ahead of time, if any
+};
+
+// ============================================================================
+// Property Definition — describes a single configurable property
+// ============================================================================
+
+struct PropertyDef {
+    const char *key;          // Property name (e.g., "textbox.color")
+    PropType type;            // Type of the property
+    const char *description;  // Human-readable description
+
+    // Write a parsed value straight into its UiConfig member (plus any side
+    // effect) and read the member back as a string.
+    void (*apply)(ApplyContext &ctx,
+                  const ApplyValue &val);
+    std::string (*get)(const UiConfig &cfg);
 };
 
+// ============================================================================
+// Property Patch — a property with its value parsed and validated
+// ============================================================================
+
+// What a ui block compiles to: applying it is a direct member write, with
+// no lookup or parsing left to do.
+struct PropertyPatch {
+    const PropertyDef *def = nullptr;
+    ApplyValue value;
+};
+
+// Resolve key and parse value. False, with a message in error, if the key
+// is unknown or the value does not parse as the property's type.
+bool compilePatch(const std::string &key,
+                  const std::string &value,
+                  PropertyPatch &out,
+                  std::string &error);
+
 // ============================================================================
 // Dispatcher — parse based on type enum
 // ============================================================================
 
+// Parsers are strict: trailing junk, out-of-range colors and unknown key
+// names leave ok false.
 ApplyValue parseByType(PropType type,
                        const std::string &str);
 
+// Every name a KeyList accepts, space-separated ("space enter ... mouse3").
+const std::string &keyNames();
+
 // ============================================================================
 // Type Parsers — convert string to typed value
 // ============================================================================
@@ -119,33 +154,4 @@ std::string serializeTexture(const std::string &path);
 
 }  // namespace serializers
 
-// ============================================================================
-// Type Handlers — apply typed value to UiConfig
-// ============================================================================
-
-namespace handlers {
-
-void applyFloat(ApplyContext &ctx,
-                ApplyValue &val);
-void applyInt(ApplyContext &ctx,
-              ApplyValue &val);
-void applyString(ApplyContext &ctx,
-                 ApplyValue &val);
-void applyBool(ApplyContext &ctx,
-               ApplyValue &val);
-void applyColor(ApplyContext &ctx,
-                ApplyValue &val,
-                SDL_Color *target);
-void applyDim(ApplyContext &ctx,
-              ApplyValue &val,
-              Dim *target);
-void applyKeyList(ApplyContext &ctx,
-                  ApplyValue &val);
-void applyTexture(ApplyContext &ctx,
-                  ApplyValue &val,
-                  SDL_Texture *&targetTex,
-                  std::string &targetPath);
-
-}  // namespace handlers
-
 }  // namespace config
@@ -3,7 +3,8 @@
 #include "engine_impl.hpp"
 #include <algorithm>
 
-void Impl::Draw()
+// Background, fade overlay and characters — everything a dissolve snapshot captures.
+void Impl::DrawScene()
 {
     SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255);
     SDL_RenderClear(renderer);
@@ -25,7 +26,7 @@ void Impl::Draw()
     for (const auto &[id, entry] : scene.Characters()) {
         float tw = 0, th = 0;
         SDL_GetTextureSize(entry.tex, &tw, &th);
-        float scale = (screenHeight * 0.8f) / th;
+        float scale = (screenHeight * SceneManager::CHARACTER_HEIGHT) / th;
         float centreX = screenWidth * entry.xNorm;
         SDL_FRect dst{centreX - tw * scale * 0.5f,
                       screenHeight - th * scale - screenHeight * 0.1f,
@@ -33,115 +34,258 @@ void Impl::Draw()
                       th * scale};
         SDL_RenderTexture(renderer, entry.tex, nullptr, &dst);
     }
+}
+
+// Render the current scene once into the snapshot target so a dissolve can
+// blend it out as a single quad instead of redrawing the old scene per frame.
+void Impl::CaptureScene()
+{
+    SDL_Texture *target = scene.SnapshotTarget(screenWidth, screenHeight);
+    if (!target)
+        return;
+    SDL_SetRenderTarget(renderer, target);
+    DrawScene();
+    SDL_SetRenderTarget(renderer, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// Overlay backdrops — what an overlay covers, rendered once when it opens
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr int MAX_BLUR = 4;
+
+void dim(SDL_Renderer *renderer,
+         int alpha)
+{
+    if (alpha <= 0)
+        return;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, (Uint8)std::min(alpha, 255));
+    SDL_RenderFillRect(renderer, nullptr);
+}
+
+// Soften `tex` by rendering it down `steps` halvings with linear filtering
+// and back up. The GPU's bilinear taps do the averaging.
+void blur(SDL_Renderer *renderer,
+          SDL_Texture *tex,
+          int w,
+          int h,
+          int steps)
+{
+    std::array<SDL_Texture *, MAX_BLUR> chain{};
+    SDL_Texture *src = tex;
+    int n = 0;
+    for (; n < steps; ++n) {
+        w = std::max(w / 2, 1);
+        h = std::max(h / 2, 1);
+        chain[n] =
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!chain[n])
+            break;
+        SDL_SetTextureScaleMode(src, SDL_SCALEMODE_LINEAR);
+        SDL_SetTextureBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetRenderTarget(renderer, chain[n]);
+        SDL_RenderTexture(renderer, src, nullptr, nullptr);
+        src = chain[n];
+    }
+    if (src != tex) {
+        SDL_SetTextureScaleMode(src, SDL_SCALEMODE_LINEAR);
+        SDL_SetTextureBlendMode(src, SDL_BLENDMODE_NONE);
+        SDL_SetRenderTarget(renderer, tex);
+        SDL_RenderTexture(renderer, src, nullptr, nullptr);
+    }
+    for (int i = 0; i < n; ++i)
+        SDL_DestroyTexture(chain[i]);
+}
 
-    // --- Menu buttons ---
-    if (menu.IsOpen()) {
-        const float bw = uiCfg.button.w;
-        const float bh = uiCfg.button.h;
-        const float spacing = 20.0f;
-        float y = screenHeight * 0.4f;
-        const auto &buttonTexts = menu.Texts();
-
-        for (size_t i = 0; i < buttonTexts.size(); ++i) {
-            SDL_FRect btn{(float)screenWidth / 2.0f - bw / 2.0f, y, bw, bh};
-
-            if (uiCfg.button.image) {
-                SDL_RenderTexture(renderer, uiCfg.button.image, nullptr, &btn);
-            }
-            else {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer,
-                                       uiCfg.button.color.r,
-                                       uiCfg.button.color.g,
-                                       uiCfg.button.color.b,
-                                       uiCfg.button.color.a);
-                SDL_RenderFillRect(renderer, &btn);
-            }
-
-            auto textTex = RenderText(buttonTexts[i], uiCfg.button.textColor);
-            if (textTex) {
-                float tw2, th2;
-                SDL_GetTextureSize(textTex, &tw2, &th2);
-                SDL_FRect tr{
-                    (float)screenWidth / 2.0f - tw2 / 2.0f, y + bh / 2.0f - th2 / 2.0f, tw2, th2};
-                SDL_RenderTexture(renderer, textTex, nullptr, &tr);
-                SDL_DestroyTexture(textTex);
-            }
-            y += bh + spacing;
-        }
+}  // namespace
+
+// Draws what lies under the overlay at stack `level` (the base state and
+// any overlays below it) into that level's target, with the theme's dim
+// and blur applied. Overlays then draw this one texture every frame instead.
+void Impl::CaptureBackdrop(size_t level)
+{
+    if (level >= backdrops.size())
+        return;
+    SDL_Texture *&tex = backdrops[level];
+    float tw = 0.0f, th = 0.0f;
+    if (tex && (!SDL_GetTextureSize(tex, &tw, &th) || (int)tw != screenWidth ||
+                (int)th != screenHeight))
+    {
+        SDL_DestroyTexture(tex);
+        tex = nullptr;
+    }
+    if (!tex) {
+        tex = SDL_CreateTexture(renderer,
+                                SDL_PIXELFORMAT_RGBA8888,
+                                SDL_TEXTUREACCESS_TARGET,
+                                screenWidth,
+                                screenHeight);
     }
+    // Without render targets the overlay keeps drawing the live scene.
+    backdropValid[level] = tex != nullptr;
+    if (!tex)
+        return;
+
+    SDL_Texture *prev = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, tex);
+    states.drawBelow(level);
+    blur(renderer, tex, screenWidth, screenHeight, std::clamp(uiCfg.overlay.blur, 0, MAX_BLUR));
+    dim(renderer, uiCfg.overlay.dim);
+    SDL_SetRenderTarget(renderer, prev);
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+}
 
-    // --- Save/Load overlay (drawn on top of everything, before dialogue box) ---
-    if (state == CerekaState::SaveMenuState)
-        DrawSaveLoadOverlay(true);
-    else if (state == CerekaState::LoadMenuState)
-        DrawSaveLoadOverlay(false);
+// Render targets lost their contents (device reset): capture every open
+// overlay's backdrop again, bottom up, since each one sits on the last.
+void Impl::RecaptureBackdrops()
+{
+    for (size_t level = 0; level < states.overlayDepth(); ++level)
+        CaptureBackdrop(level);
+}
 
-    if (state == CerekaState::SaveMenuState || state == CerekaState::LoadMenuState)
+void Impl::DrawBackdrop()
+{
+    size_t level = states.overlayDepth() - 1;
+    if (level < backdrops.size() && backdropValid[level]) {
+        SDL_RenderTexture(renderer, backdrops[level], nullptr, nullptr);
         return;
+    }
+    states.drawBelow(level);
+    dim(renderer, uiCfg.overlay.dim);
+}
+
+void Impl::DestroyBackdrops()
+{
+    for (SDL_Texture *&tex : backdrops) {
+        if (tex)
+            SDL_DestroyTexture(tex);
+        tex = nullptr;
+    }
+    backdropValid = {};
+}
+
+// Each state draws its own layers (src/state/cereka_states.cpp); overlays
+// are drawn over the state beneath them.
+void Impl::Draw()
+{
+    states.draw();
+}
+
+// Scene plus a dissolve in progress: the outgoing scene snapshot over the
+// live incoming scene.
+void Impl::DrawStage()
+{
+    DrawScene();
+    if (scene.Dissolving()) {
+        SDL_SetTextureAlphaModFloat(scene.Snapshot(), scene.DissolveAlpha());
+        SDL_RenderTexture(renderer, scene.Snapshot(), nullptr, nullptr);
+    }
+}
+
+void Impl::DrawMenu()
+{
+    BuildMenuUi();
+    menuUi.Draw(screenWidth, screenHeight);
+}
+
+void Impl::DrawDialogueBox()
+{
+    UpdateDialogueUi();
+    dialogueUi.Draw(screenWidth, screenHeight);
+}
+
+// ---------------------------------------------------------------------------
+// Retained UI screens — layout rebuilt only when the theme, the screen size
+// or the content changes; per-frame work is state updates on the tree.
+// ---------------------------------------------------------------------------
+
+void Impl::BuildMenuUi()
+{
+    auto key = ui::WidgetTree::KeyOf(
+        {themeVersion, (std::uint64_t)screenWidth, (std::uint64_t)screenHeight, menu.Generation()});
+    if (menuUi.LayoutKey() == key)
+        return;
+    menuUi.Clear();
+    menuUi.SetLayoutKey(key);
+
+    const float bw = uiCfg.button.w;
+    const float bh = uiCfg.button.h;
+    const float spacing = 20.0f;
+    float y = screenHeight * 0.4f;
+    const auto &buttonTexts = menu.Texts();
+    for (size_t i = 0; i < buttonTexts.size(); ++i) {
+        ui::Widget btn;
+        btn.kind = ui::Widget::Kind::Button;
+        btn.id = (int)i;
+        btn.rect = {(float)screenWidth / 2.0f - bw / 2.0f, y, bw, bh};
+        btn.style = {uiCfg.button.color,
+                     uiCfg.button.image,
+                     uiCfg.button.hoverImage,
+                     uiCfg.button.textColor};
+        btn.text = buttonTexts[i];
+        menuUi.Add(std::move(btn));
+        y += bh + spacing;
+    }
+}
+
+namespace {
+// Fixed widget order of the dialogue screen
+enum DialogueWidget { DLG_TEXTBOX, DLG_NAMEBOX, DLG_NAME, DLG_TEXT };
+}  // namespace
+
+void Impl::UpdateDialogueUi()
+{
+    auto key = ui::WidgetTree::KeyOf(
+        {themeVersion, (std::uint64_t)screenWidth, (std::uint64_t)screenHeight});
+    if (dialogueUi.LayoutKey() != key) {
+        dialogueUi.Clear();
+        dialogueUi.SetLayoutKey(key);
 
-    // --- Dialogue box ---
-    if (!dialogue.Text().empty()) {
         float tbY = uiCfg.textbox.y.resolve((float)screenHeight);
         float tbH = uiCfg.textbox.h.resolve((float)screenHeight);
-        float tbW = (float)screenWidth;
-
-        if (uiCfg.textbox.image) {
-            SDL_FRect tb{0, tbY, tbW, tbH};
-            SDL_RenderTexture(renderer, uiCfg.textbox.image, nullptr, &tb);
-        }
-        else {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(renderer,
-                                   uiCfg.textbox.color.r,
-                                   uiCfg.textbox.color.g,
-                                   uiCfg.textbox.color.b,
-                                   uiCfg.textbox.color.a);
-            SDL_FRect tb{0, tbY, tbW, tbH};
-            SDL_RenderFillRect(renderer, &tb);
-        }
-
-        // Name box
-        if (!dialogue.Speaker().empty()) {
-            float nbY = tbY + uiCfg.namebox.yOffset;
-            SDL_FRect nb{uiCfg.namebox.x, nbY, uiCfg.namebox.w, uiCfg.namebox.h};
-
-            if (uiCfg.namebox.image) {
-                SDL_RenderTexture(renderer, uiCfg.namebox.image, nullptr, &nb);
-            }
-            else {
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer,
-                                       uiCfg.namebox.color.r,
-                                       uiCfg.namebox.color.g,
-                                       uiCfg.namebox.color.b,
-                                       uiCfg.namebox.color.a);
-                SDL_RenderFillRect(renderer, &nb);
-            }
-
-            auto nameTex = RenderText(dialogue.Name(), uiCfg.namebox.textColor);
-            if (nameTex) {
-                float nw, nh;
-                SDL_GetTextureSize(nameTex, &nw, &nh);
-                SDL_FRect dst{
-                    uiCfg.namebox.x + 15.0f, nbY + (uiCfg.namebox.h - nh) / 2.0f, nw, nh};
-                SDL_RenderTexture(renderer, nameTex, nullptr, &dst);
-                SDL_DestroyTexture(nameTex);
-            }
-        }
-
-        // Dialogue text with word wrap
-        std::string visible = dialogue.Text().substr(0, dialogue.DisplayedChars());
-        auto textTex = RenderText(visible, uiCfg.textbox.textColor);
-        if (textTex) {
-            float tw, th;
-            SDL_GetTextureSize(textTex, &tw, &th);
-            float margin = uiCfg.textbox.textMarginX;
-            float maxW = (float)screenWidth - 2.0f * margin;
-            float scale = tw > maxW ? maxW / tw : 1.0f;
-            SDL_FRect dst{margin, tbY + 40.0f, tw * scale, th * scale};
-            SDL_RenderTexture(renderer, textTex, nullptr, &dst);
-            SDL_DestroyTexture(textTex);
-        }
+        float margin = uiCfg.textbox.textMarginX;
+
+        ui::Widget textbox;
+        textbox.rect = {0.0f, tbY, (float)screenWidth, tbH};
+        textbox.style.fill = uiCfg.textbox.color;
+        textbox.style.image = uiCfg.textbox.image;
+        dialogueUi.Add(std::move(textbox));
+
+        ui::Widget namebox;
+        namebox.parent = DLG_TEXTBOX;
+        namebox.rect = {
+            uiCfg.namebox.x, tbY + uiCfg.namebox.yOffset, uiCfg.namebox.w, uiCfg.namebox.h};
+        namebox.style.fill = uiCfg.namebox.color;
+        namebox.style.image = uiCfg.namebox.image;
+        dialogueUi.Add(namebox);
+
+        ui::Widget name;
+        name.kind = ui::Widget::Kind::Label;
+        name.parent = DLG_NAMEBOX;
+        name.rect = namebox.rect;
+        name.style.text = uiCfg.namebox.textColor;
+        name.alignX = ui::Widget::Align::Start;
+        name.padX = 15.0f;
+        dialogueUi.Add(std::move(name));
+
+        ui::Widget text;
+        text.kind = ui::Widget::Kind::Label;
+        text.parent = DLG_TEXTBOX;
+        text.rect = {margin, tbY + 40.0f, (float)screenWidth - 2.0f * margin,
+                     std::max(tbH - 40.0f, 0.0f)};
+        text.style.text = uiCfg.textbox.textColor;
+        text.alignX = ui::Widget::Align::Start;
+        text.alignY = ui::Widget::Align::Start;
+        text.shrinkToFit = true;
+        dialogueUi.Add(std::move(text));
     }
+
+    // The label re-renders only when another character appears.
+    dialogueUi.SetVisible(DLG_TEXTBOX, !dialogue.Text().empty());
+    dialogueUi.SetVisible(DLG_NAMEBOX, !dialogue.Speaker().empty());
+    dialogueUi.SetText(DLG_NAME, dialogue.Name());
+    dialogueUi.SetText(DLG_TEXT, dialogue.Text().substr(0, dialogue.DisplayedChars()));
 }
@@ -4,21 +4,37 @@
 
 #include "Cereka/Cereka.hpp"
 #include "Cereka/exceptions.hpp"
+#include "archive/crpak.hpp"
+#include "asset_pack.hpp"
+#include "asset_prefetcher.hpp"
 #include "audio_manager.hpp"
 #include "config/config_manager.hpp"
 #include "dialogue_system.hpp"
+#include "global_data.hpp"
+#include "hot_reload.hpp"
 #include "menu_system.hpp"
+#include "save_index.hpp"
+#include "save_journal.hpp"
+#include "save_writer.hpp"
 #include "scene_manager.hpp"
+#include "startup_profile.hpp"
+#include "state/cereka_states.hpp"
 #include "script_interpreter.hpp"
 #include "text_renderer.hpp"
+#include "texture_cache.hpp"
 #include "ui_config.hpp"
+#include "ui_widgets.hpp"
 #include "video.hpp"
 
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include <array>
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +43,13 @@ namespace fs = std::filesystem;
 
 namespace cereka {
 
+// A background compile's result: the program and the asset manifest the
+// compile built for it, so loading the program need not build it again.
+struct CompiledProgram {
+    std::vector<scenario::Instruction> program;
+    scenario::AssetManifest manifest;
+};
+
 class CerekaImpl {
    public:
     // --- Window / renderer ---
@@ -35,18 +58,47 @@ class CerekaImpl {
     int screenWidth = 0;
     int screenHeight = 0;
 
+    // --- Input (PollEvent) ---
+    std::optional<CerekaEvent> pendingMotion;  // motion folded so far this drain
+    std::optional<CerekaEvent> heldEvent;  // returned after the motion that preceded it
+    std::vector<SDL_Gamepad *> gamepads;
+    std::uint64_t lastPresentNs = 0;  // SDL_GetTicksNS after the last Present
+    // Oldest input whose effect has not been presented yet (0: none)
+    std::uint64_t inputAwaitingPresentNs = 0;
+    LatencyHistogram inputLatency;
+
     // --- Font ---
     TTF_Font *font = nullptr;
     std::string fontPath;  // path of the loaded font file (for reloading on size change)
 
+    // --- Shared textures (scene sprites, ui images) ---
+    TextureCache textures;
+
     // --- Scene state ---
     SceneManager scene;
 
     // --- Audio ---
     AudioManager audio;
 
+    // --- Background asset decoding ---
+    AssetPrefetcher prefetcher;
+    size_t prefetchPc = SIZE_MAX;  // pc the current look-ahead window was built from
+    scenario::AssetManifest manifest;  // assets per label / region of the loaded program
+
     // --- Script interpreter ---
     ScriptInterpreter scriptInterpreter;
+    std::future<CompiledProgram> compiledScript;  // started by InitGame
+
+    // --- Dev-mode hot reload (EnableHotReload) ---
+    std::string entryScript;
+    scenario::CompileCache compileCache;  // worker-owned while a compile runs
+    ScriptWatcher scriptWatcher;
+    std::future<CompiledProgram> reloadedScript;
+    bool reloadQueued = false;  // scripts changed; recompile when none is running
+    std::chrono::steady_clock::time_point reloadStarted;
+
+    // --- Startup metrics ---
+    double timeToInteractiveMs = -1.0;
 
     // --- Dialogue ---
     DialogueSystem dialogue;
@@ -55,12 +107,50 @@ class CerekaImpl {
     MenuSystem menu;
 
     // --- State machine ---
-    CerekaState state = CerekaState::Running;
-    CerekaState stateBeforeSaveMenu = CerekaState::Running;  // restored when overlay closes
+    // Drives update, events and draw; save / load menus are overlays on it
+    EngineStates states{*this};
+
+    // --- Saves ---
+    SaveIndex saveIndex;
+    SaveWriter saveWriter;
+    SaveJournal journal;  // autosave at every line, replayed by ResumeAutosave
+    SDL_Texture *thumbnailTarget = nullptr;  // scene render target for save thumbnails
+
+    int savePage = 0;  // page shown by the save/load overlay
+    // What each open overlay sits on, captured when it opened (by stack
+    // level). Targets are kept and reused while the screen size holds.
+    std::array<SDL_Texture *, EngineStates::MAX_OVERLAYS> backdrops{};
+    std::array<bool, EngineStates::MAX_OVERLAYS> backdropValid{};
+
+    // Thumbnails of the visible page, held from the texture cache while the
+    // overlay is open
+    struct SlotThumb {
+        int slot = 0;
+        SDL_Texture *tex = nullptr;
+        bool tried = false;  // loaded or failed; not retried every frame
+    };
+    std::array<SlotThumb, SaveIndex::SLOTS_PER_PAGE> slotThumbs;
+    double playtime = 0.0;  // seconds played, carried through saves
+    std::chrono::steady_clock::time_point playtimeTick{};  // last Update, unset before the first
+
+    // --- Across playthroughs: read lines, unlocks, endings ---
+    GlobalData globalData;
 
     // --- UI theme ---
     UiConfig uiCfg;
     config::ConfigManager configManager;
+    // ui blocks of the loaded program, compiled at load; uiPatchAt maps each
+    // UI_SET pc to its patch. Patch textures hold a cache reference.
+    std::vector<config::PropertyPatch> uiPatches;
+    std::vector<int> uiPatchAt;
+    // UI_SET pcs that have run, each once, in the order they last ran.
+    std::vector<size_t> uiApplied;
+    std::uint64_t themeVersion = 0;  // bumped on any theme change; part of every layout key
+
+    // Retained widget trees, one per screen
+    ui::WidgetTree dialogueUi;
+    ui::WidgetTree menuUi;
+    ui::WidgetTree saveUi;
 
     // -----------------------------------------------------------------------
     // Methods — defined across the engine .cpp files
@@ -70,9 +160,13 @@ class CerekaImpl {
     bool InitGame(const char *title,
                   int width,
                   int height,
-                  bool fullscreen);
+                  bool fullscreen,
+                  const std::string &entryScript);
     void ShutDown();
+    void FilterEvents();
     bool PollEvent(CerekaEvent &e);
+    bool TranslateEvent(const SDL_Event &sdl,
+                        CerekaEvent &e);
     void Present();
     SDL_Renderer *CreateBestRenderer(SDL_Window *win);
     SDL_Texture *RenderText(const std::string &text,
@@ -85,28 +179,58 @@ class CerekaImpl {
     void EnterMenu();
     void ExitMenu();
     void HandleEvent(const CerekaEvent &e);
+    void ChooseMenuOption(size_t idx);
 
     // script_vm.cpp
     void TickScript();
     void Update(float dt);
-    void LoadCompiledScript(const std::vector<scenario::Instruction> &compiled);
+    void PrefetchAhead();
+    // built, if given, is the manifest compiled alongside the program.
+    void LoadCompiledScript(const std::vector<scenario::Instruction> &compiled,
+                            std::optional<scenario::AssetManifest> built = std::nullopt);
+    bool LoadEntryScript();
+    void IndexProgram(std::optional<scenario::AssetManifest> built);
+    bool EnableHotReload();
+    void PollHotReload();
+    void HotSwapProgram(std::vector<scenario::Instruction> program,
+                        scenario::AssetManifest built);
+    std::vector<scenario::Instruction> TakeCompiledScript();
     void LoadScript(const std::string &filename);
     void Reset();
 
     // draw.cpp
     void Draw();
+    void DrawScene();
+    void DrawStage();
+    void DrawMenu();
+    void DrawDialogueBox();
+    void CaptureScene();
+    void CaptureBackdrop(size_t level);
+    void RecaptureBackdrops();
+    void DrawBackdrop();
+    void DestroyBackdrops();
+    void BuildMenuUi();
+    void UpdateDialogueUi();
 
     // save.cpp
     bool SaveGame(int slot);
     bool LoadGame(int slot);
-    std::string GetSlotTimestamp(int slot);
+    SerializableSaveData CaptureSaveData();
+    void ApplySaveData(const SerializableSaveData &data);
+    void Autosave(size_t pc);
+    bool ResumeAutosave();
+    SDL_Surface *CaptureThumbnail();
+    void ReleaseSlotThumbs();
+    void BuildSaveUi(bool isSaving);
     void DrawSaveLoadOverlay(bool isSaving);
-    int HitTestSaveSlot(int mx,
-                        int my);
+    void ActivateSaveWidget(int id,
+                            bool isSaving);
+    void TurnSavePage(int delta);
 
     // ui_config.cpp
-    void ApplyUiSet(const std::string &key,
-                    const std::string &val);
+    void CompileUiPatches();
+    void ReleaseUiPatches();
+    void ApplyUiPatch(size_t pc);
     void InitConfigManager();
     void LoadFont(int size);
 };
@@ -0,0 +1,414 @@
+#include "global_data.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#    include <io.h>
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cereka {
+
+namespace {
+
+constexpr std::size_t PAGE_BYTES = 4096;
+
+std::uint64_t fnv1a(std::uint64_t h,
+                    const void *data,
+                    std::size_t size)
+{
+    auto *p = (const unsigned char *)data;
+    for (std::size_t i = 0; i < size; ++i)
+        h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+bool syncFile(std::FILE *f)
+{
+    if (std::fflush(f) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// MappedBitset
+// ---------------------------------------------------------------------------
+
+MappedBitset::~MappedBitset()
+{
+    Close();
+}
+
+bool MappedBitset::Open(const std::string &basePath)
+{
+    Close();
+    base = basePath;
+    std::error_code ec;
+    fs::path dir = fs::path(base).parent_path();
+    if (!dir.empty())
+        fs::create_directories(dir, ec);
+
+    // Key table: whole entries only; a torn tail from a crash is dropped.
+    std::string keyPath = base + ".keys";
+    if (std::FILE *f = std::fopen(keyPath.c_str(), "rb")) {
+        unsigned char buf[8];
+        while (std::fread(buf, 1, sizeof(buf), f) == sizeof(buf)) {
+            std::uint64_t key = 0;
+            for (int i = 0; i < 8; ++i)
+                key |= (std::uint64_t)buf[i] << (8 * i);
+            indexOf.emplace(key, (std::uint32_t)keys.size());
+            keys.push_back(key);
+        }
+        std::fclose(f);
+        if (fs::file_size(keyPath, ec) != keys.size() * 8)
+            fs::resize_file(keyPath, keys.size() * 8, ec);
+    }
+    keyFile = std::fopen(keyPath.c_str(), "ab");
+    if (!keyFile) {
+        std::cerr << "[CEREKA] Cannot open " << keyPath << "\n";
+        Close();
+        return false;
+    }
+
+    std::size_t need = (keys.size() + 7) / 8;
+    if (!mapBits((need / PAGE_BYTES + 1) * PAGE_BYTES)) {
+        std::cerr << "[CEREKA] Cannot map " << base << ".bits\n";
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedBitset::Close()
+{
+    if (bits)
+        Sync();
+    if (keyFile) {
+        syncFile(keyFile);
+        std::fclose(keyFile);
+        keyFile = nullptr;
+    }
+    unmapBits();
+    keys.clear();
+    indexOf.clear();
+    unflushedKeys = 0;
+}
+
+std::uint32_t MappedBitset::Index(std::uint64_t key)
+{
+    auto it = indexOf.find(key);
+    if (it != indexOf.end())
+        return it->second;
+    if (!keyFile)
+        return NONE;
+
+    std::uint32_t bit = (std::uint32_t)keys.size();
+    if (bit >= capacity) {
+        // Double the file so a large script costs a handful of remaps.
+        if (!mapBits(std::max(mappedBytes * 2, PAGE_BYTES)))
+            return NONE;
+    }
+    unsigned char buf[8];
+    for (int i = 0; i < 8; ++i)
+        buf[i] = (unsigned char)(key >> (8 * i));
+    if (std::fwrite(buf, 1, sizeof(buf), keyFile) != sizeof(buf))
+        return NONE;
+    keys.push_back(key);
+    indexOf.emplace(key, bit);
+    ++unflushedKeys;
+    return bit;
+}
+
+std::uint32_t MappedBitset::Find(std::uint64_t key) const
+{
+    auto it = indexOf.find(key);
+    return it != indexOf.end() ? it->second : NONE;
+}
+
+bool MappedBitset::FlushKeys()
+{
+    if (!keyFile || unflushedKeys == 0)
+        return true;
+    unflushedKeys = 0;
+    return syncFile(keyFile);
+}
+
+std::size_t MappedBitset::Count() const
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < mappedBytes; ++i)
+        n += std::popcount(bits[i]);
+    return n;
+}
+
+bool MappedBitset::Sync()
+{
+    std::lock_guard<std::mutex> lock(mapMutex);
+    if (!bits || !dirty.exchange(false, std::memory_order_relaxed))
+        return true;
+#ifdef _WIN32
+    return FlushViewOfFile(bits, 0) && FlushFileBuffers((HANDLE)file);
+#else
+    return msync(bits, mappedBytes, MS_SYNC) == 0;
+#endif
+}
+
+// (Re)map <base>.bits at least `bytes` long, keeping what it holds.
+bool MappedBitset::mapBits(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mapMutex);
+    std::string path = base + ".bits";
+#ifdef _WIN32
+    if (bits) {
+        UnmapViewOfFile(bits);
+        CloseHandle((HANDLE)mapping);
+        bits = nullptr;
+        mapping = nullptr;
+    }
+    if (!file) {
+        HANDLE h = CreateFileA(path.c_str(),
+                               GENERIC_READ | GENERIC_WRITE,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               OPEN_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr);
+        if (h == INVALID_HANDLE_VALUE)
+            return false;
+        file = h;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)file, &size))
+        return false;
+    bytes = std::max(bytes, (std::size_t)size.QuadPart);
+    LARGE_INTEGER want;
+    want.QuadPart = (LONGLONG)bytes;
+    mapping = CreateFileMappingA((HANDLE)file, nullptr, PAGE_READWRITE, want.HighPart,
+                                 want.LowPart, nullptr);
+    if (!mapping)
+        return false;
+    bits = (std::uint8_t *)MapViewOfFile((HANDLE)mapping, FILE_MAP_WRITE, 0, 0, 0);
+    if (!bits) {
+        CloseHandle((HANDLE)mapping);
+        mapping = nullptr;
+        return false;
+    }
+#else
+    if (bits) {
+        munmap(bits, mappedBytes);
+        bits = nullptr;
+    }
+    if (fd < 0) {
+        fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        return false;
+    bytes = std::max(bytes, (std::size_t)st.st_size);
+    if ((std::size_t)st.st_size < bytes && ftruncate(fd, (off_t)bytes) != 0)
+        return false;
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return false;
+    bits = (std::uint8_t *)p;
+#endif
+    mappedBytes = bytes;
+    capacity = (std::uint32_t)std::min<std::size_t>(bytes * 8, NONE);
+    return true;
+}
+
+void MappedBitset::unmapBits()
+{
+    std::lock_guard<std::mutex> lock(mapMutex);
+#ifdef _WIN32
+    if (bits)
+        UnmapViewOfFile(bits);
+    if (mapping)
+        CloseHandle((HANDLE)mapping);
+    if (file)
+        CloseHandle((HANDLE)file);
+    file = mapping = nullptr;
+#else
+    if (bits)
+        munmap(bits, mappedBytes);
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+#endif
+    bits = nullptr;
+    mappedBytes = 0;
+    capacity = 0;
+}
+
+// ---------------------------------------------------------------------------
+// GlobalData
+// ---------------------------------------------------------------------------
+
+GlobalData::~GlobalData()
+{
+    Close();
+}
+
+bool GlobalData::Open(const std::string &dir)
+{
+    bool ok = seen.Open(dir + "/seen");
+    ok = unlocks.Open(dir + "/unlocks") && ok;
+    ok = endings.Open(dir + "/endings") && ok;
+    return ok;
+}
+
+void GlobalData::Close()
+{
+    Stop();
+    seen.Close();
+    unlocks.Close();
+    endings.Close();
+    lineBits.clear();
+}
+
+void GlobalData::Start()
+{
+    Stop();
+    stopping = false;
+    flusher = std::thread([this] { flushLoop(); });
+}
+
+void GlobalData::Stop()
+{
+    if (!flusher.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopCv.notify_all();
+    flusher.join();
+}
+
+void GlobalData::BindProgram(const std::vector<scenario::Instruction> &program)
+{
+    using scenario::Op;
+
+    lineBits.assign(program.size(), MappedBitset::NONE);
+    std::unordered_map<std::uint64_t, std::uint32_t> occurrences;
+    for (std::size_t pc = 0; pc < program.size(); ++pc) {
+        const auto &ins = program[pc];
+        switch (ins.op) {
+            case Op::SAY:
+            case Op::NARRATE: {
+                std::uint32_t &n = occurrences[LineKey(ins, 0)];
+                lineBits[pc] = seen.Index(LineKey(ins, n++));
+                break;
+            }
+            case Op::UNLOCK:
+                unlocks.Index(NameKey(ins.a));
+                break;
+            case Op::ENDING:
+                endings.Index(NameKey(ins.a));
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Keys must be on disk before any of their bits can be.
+    seen.FlushKeys();
+    unlocks.FlushKeys();
+    endings.FlushKeys();
+}
+
+void GlobalData::Unlock(const std::string &name)
+{
+    std::uint64_t key = NameKey(name);
+    std::uint32_t bit = unlocks.Find(key);
+    if (bit == MappedBitset::NONE) {
+        // Not named by the script (set through the API): index it now.
+        bit = unlocks.Index(key);
+        unlocks.FlushKeys();
+    }
+    unlocks.Set(bit);
+}
+
+bool GlobalData::IsUnlocked(const std::string &name) const
+{
+    std::uint32_t bit = unlocks.Find(NameKey(name));
+    return bit != MappedBitset::NONE && unlocks.Test(bit);
+}
+
+void GlobalData::ReachEnding(const std::string &name)
+{
+    std::uint64_t key = NameKey(name);
+    std::uint32_t bit = endings.Find(key);
+    if (bit == MappedBitset::NONE) {
+        bit = endings.Index(key);
+        endings.FlushKeys();
+    }
+    endings.Set(bit);
+}
+
+bool GlobalData::HasReachedEnding(const std::string &name) const
+{
+    std::uint32_t bit = endings.Find(NameKey(name));
+    return bit != MappedBitset::NONE && endings.Test(bit);
+}
+
+std::uint64_t GlobalData::LineKey(const scenario::Instruction &ins,
+                                  std::uint32_t occurrence)
+{
+    const char sep = 0;
+    char op = ins.op == scenario::Op::SAY ? 'S' : 'N';
+    std::uint64_t h = fnv1a(FNV_OFFSET, &op, 1);
+    h = fnv1a(h, ins.a.data(), ins.a.size());
+    h = fnv1a(h, &sep, 1);
+    h = fnv1a(h, ins.b.data(), ins.b.size());
+    h = fnv1a(h, &sep, 1);
+    unsigned char n[4];
+    for (int i = 0; i < 4; ++i)
+        n[i] = (unsigned char)(occurrence >> (8 * i));
+    return fnv1a(h, n, sizeof(n));
+}
+
+std::uint64_t GlobalData::NameKey(const std::string &name)
+{
+    return fnv1a(FNV_OFFSET, name.data(), name.size());
+}
+
+void GlobalData::flushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopCv.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping; })) {
+        lock.unlock();
+        sync();
+        lock.lock();
+    }
+}
+
+bool GlobalData::sync()
+{
+    bool ok = seen.Sync();
+    ok = unlocks.Sync() && ok;
+    ok = endings.Sync() && ok;
+    return ok;
+}
+
+}  // namespace cereka
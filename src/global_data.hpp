@@ -0,0 +1,154 @@
+#pragma once
+#include "compiler/vn_instruction.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cereka {
+
+// A bitset living in a memory-mapped file, addressed through a table of
+// stable 64-bit keys so a bit keeps its meaning when the script around it
+// changes.
+//
+// <base>.keys lists the keys in bit order (u64 LE each, append-only) and
+// <base>.bits holds the bits, padded to whole pages. Setting a bit is a
+// plain store into the mapping; Sync (or the OS) writes it back.
+//
+// Index and Set belong to one thread; Sync may run on another.
+class MappedBitset {
+   public:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    MappedBitset() = default;
+    MappedBitset(const MappedBitset &) = delete;
+    MappedBitset &operator=(const MappedBitset &) = delete;
+    ~MappedBitset();
+
+    bool Open(const std::string &base);
+    // Syncs first.
+    void Close();
+    bool IsOpen() const { return bits != nullptr; }
+
+    // Bit for key, appended to the key table if it is new. New keys reach
+    // the disk on FlushKeys, which must happen before their bits are set.
+    std::uint32_t Index(std::uint64_t key);
+    // NONE if key was never indexed.
+    std::uint32_t Find(std::uint64_t key) const;
+    bool FlushKeys();
+
+    void Set(std::uint32_t bit)
+    {
+        if (bit >= capacity)
+            return;
+        std::uint8_t mask = (std::uint8_t)(1u << (bit & 7));
+        if (!(bits[bit >> 3] & mask)) {
+            bits[bit >> 3] |= mask;
+            dirty.store(true, std::memory_order_relaxed);
+        }
+    }
+    bool Test(std::uint32_t bit) const
+    {
+        return bit < capacity && (bits[bit >> 3] >> (bit & 7)) & 1;
+    }
+    std::size_t Count() const;
+    std::size_t Size() const { return keys.size(); }
+
+    // Write modified pages back if anything changed since the last call.
+    bool Sync();
+
+   private:
+    bool mapBits(std::size_t bytes);
+    void unmapBits();
+
+    std::string base;
+    std::vector<std::uint64_t> keys;
+    std::unordered_map<std::uint64_t, std::uint32_t> indexOf;
+    std::FILE *keyFile = nullptr;  // append handle
+    std::size_t unflushedKeys = 0;
+
+    std::mutex mapMutex;  // remapping vs Sync
+    std::uint8_t *bits = nullptr;
+    std::size_t mappedBytes = 0;
+    std::uint32_t capacity = 0;  // bits
+    std::atomic<bool> dirty{false};
+#ifdef _WIN32
+    void *file = nullptr;  // HANDLEs
+    void *mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+// Data that outlives playthroughs: which lines have been read, what has
+// been unlocked (CGs, gallery entries) and which endings were reached.
+//
+// Every say / narrate of the loaded program gets its bit up front, so
+// marking a line as read is one store into mapped memory. A background
+// thread syncs the files every FLUSH_INTERVAL while anything changed.
+class GlobalData {
+   public:
+    static constexpr std::chrono::seconds FLUSH_INTERVAL{2};
+
+    GlobalData() = default;
+    GlobalData(const GlobalData &) = delete;
+    GlobalData &operator=(const GlobalData &) = delete;
+    ~GlobalData();
+
+    // Files go to dir/seen.*, dir/unlocks.* and dir/endings.*.
+    bool Open(const std::string &dir = "saves");
+    // Stops the flush thread and syncs.
+    void Close();
+    void Start();
+    void Stop();
+
+    // Index every line of program and every name its unlock / ending
+    // instructions use.
+    void BindProgram(const std::vector<scenario::Instruction> &program);
+
+    void MarkSeen(std::size_t pc)
+    {
+        if (pc < lineBits.size())
+            seen.Set(lineBits[pc]);
+    }
+    bool Seen(std::size_t pc) const
+    {
+        return pc < lineBits.size() && seen.Test(lineBits[pc]);
+    }
+    std::size_t SeenCount() const { return seen.Count(); }
+
+    void Unlock(const std::string &name);
+    bool IsUnlocked(const std::string &name) const;
+    void ReachEnding(const std::string &name);
+    bool HasReachedEnding(const std::string &name) const;
+
+    // Identity of the occurrence-th line with this op, speaker and text;
+    // unchanged by edits elsewhere in the script.
+    static std::uint64_t LineKey(const scenario::Instruction &ins,
+                                 std::uint32_t occurrence);
+    static std::uint64_t NameKey(const std::string &name);
+
+   private:
+    void flushLoop();
+    bool sync();
+
+    MappedBitset seen;
+    MappedBitset unlocks;
+    MappedBitset endings;
+    std::vector<std::uint32_t> lineBits;  // per pc; NONE for non-lines
+
+    std::mutex mutex;
+    std::condition_variable stopCv;
+    bool stopping = false;
+    std::thread flusher;
+};
+
+}  // namespace cereka
@@ -0,0 +1,170 @@
+#include "hot_reload.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cereka {
+
+// ---------------------------------------------------------------------------
+// ScriptWatcher
+// ---------------------------------------------------------------------------
+
+ScriptWatcher::~ScriptWatcher()
+{
+    Stop();
+}
+
+bool ScriptWatcher::Watch(const std::vector<std::string> &paths)
+{
+    Stop();
+    std::error_code ec;
+    for (const auto &p : paths) {
+        std::string path = fs::absolute(p, ec).lexically_normal().string();
+        files[path] = fs::last_write_time(path, ec);
+    }
+    if (files.empty())
+        return false;
+
+#ifdef __linux__
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0) {
+        for (const auto &[path, mtime] : files) {
+            std::string dir = fs::path(path).parent_path().string();
+            if (std::any_of(dirOf.begin(), dirOf.end(), [&](auto &d) { return d.second == dir; }))
+                continue;
+            int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (wd >= 0)
+                dirOf[wd] = dir;
+        }
+        if (dirOf.empty()) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0)
+        std::cerr << "[CEREKA] inotify unavailable; polling scripts for changes\n";
+#endif
+    nextPoll = std::chrono::steady_clock::now() + POLL_INTERVAL;
+    return true;
+}
+
+void ScriptWatcher::Stop()
+{
+#ifdef __linux__
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+    dirOf.clear();
+#endif
+    files.clear();
+}
+
+bool ScriptWatcher::Changed()
+{
+#ifdef __linux__
+    if (fd >= 0) {
+        bool hit = false;
+        alignas(inotify_event) char buf[4096];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0) {
+            for (char *p = buf; p < buf + n;) {
+                auto *ev = (const inotify_event *)p;
+                p += sizeof(inotify_event) + ev->len;
+                if (ev->len == 0)
+                    continue;
+                auto dir = dirOf.find(ev->wd);
+                if (dir != dirOf.end() && files.count((fs::path(dir->second) / ev->name).string()))
+                    hit = true;
+            }
+        }
+        return hit;
+    }
+#endif
+    return pollTimes();
+}
+
+bool ScriptWatcher::pollTimes()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextPoll)
+        return false;
+    nextPoll = now + POLL_INTERVAL;
+
+    bool changed = false;
+    std::error_code ec;
+    for (auto &[path, mtime] : files) {
+        auto t = fs::last_write_time(path, ec);
+        if (!ec && t != mtime) {
+            mtime = t;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// ---------------------------------------------------------------------------
+// MapProgramCounter
+// ---------------------------------------------------------------------------
+
+std::size_t MapProgramCounter(const std::vector<scenario::Instruction> &oldProgram,
+                              std::size_t oldPc,
+                              const std::vector<scenario::Instruction> &newProgram,
+                              const std::unordered_map<std::string, std::size_t> &newLabels)
+{
+    using scenario::Op;
+
+    if (oldPc >= oldProgram.size())
+        return newProgram.size();
+
+    std::size_t anchor = oldPc;
+    while (anchor > 0 && oldProgram[anchor].op != Op::LABEL)
+        --anchor;
+    bool labelled = oldProgram[anchor].op == Op::LABEL;
+
+    const scenario::Instruction &from = oldProgram[oldPc];
+
+    // Region of newProgram to search and the line its positions count from
+    // (the label's, when the instruction is in the label's file).
+    std::size_t start = 0;
+    std::size_t end = newProgram.size();
+    int oldBase = 0;
+    int newBase = 0;
+    auto it = labelled ? newLabels.find(oldProgram[anchor].a) : newLabels.end();
+    if (it != newLabels.end()) {
+        start = it->second;
+        if (oldProgram[anchor].srcFile == from.srcFile &&
+            newProgram[start].srcFile == from.srcFile)
+        {
+            oldBase = oldProgram[anchor].srcLine;
+            newBase = newProgram[start].srcLine;
+        }
+    }
+    if (!labelled || it != newLabels.end()) {
+        end = start + 1;
+        while (end < newProgram.size() && newProgram[end].op != Op::LABEL)
+            ++end;
+    }
+
+    // Synthesized instructions (call expansion) have no line; keep their
+    // distance from the label instead.
+    if (from.srcLine == 0)
+        return std::min(start + (oldPc - (labelled ? anchor : 0)), end);
+
+    int line = from.srcLine - oldBase;
+    for (std::size_t i = start; i < end; ++i) {
+        const scenario::Instruction &to = newProgram[i];
+        if (to.srcFile == from.srcFile && to.srcLine != 0 && to.srcLine - newBase >= line)
+            return i;
+    }
+    // Everything from here on was deleted: carry on after the region.
+    return end;
+}
+
+}  // namespace cereka
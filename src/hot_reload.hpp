@@ -0,0 +1,59 @@
+#pragma once
+#include "compiler/vn_instruction.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cereka {
+
+// Tells when any of a set of script files was written. Linux uses inotify
+// on the files' directories (editors often save by renaming a temp file
+// over the original); elsewhere modification times are compared every
+// POLL_INTERVAL. Changed never blocks, so it can run once per frame.
+class ScriptWatcher {
+   public:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{250};
+
+    ScriptWatcher() = default;
+    ScriptWatcher(const ScriptWatcher &) = delete;
+    ScriptWatcher &operator=(const ScriptWatcher &) = delete;
+    ~ScriptWatcher();
+
+    // Replace the watched set. False if nothing could be watched.
+    bool Watch(const std::vector<std::string> &files);
+    void Stop();
+    bool Watching() const { return !files.empty(); }
+
+    // True once per burst of writes to the watched files since the last call.
+    bool Changed();
+
+   private:
+    bool pollTimes();
+
+    std::unordered_map<std::string, std::filesystem::file_time_type> files;  // path -> mtime
+    std::chrono::steady_clock::time_point nextPoll{};
+#ifdef __linux__
+    int fd = -1;
+    std::unordered_map<int, std::string> dirOf;  // watch descriptor -> directory
+#endif
+};
+
+// Where execution at oldPc of oldProgram continues in newProgram.
+//
+// The instruction is located by the label it follows and its source file
+// and line. Lines in the label's own file count from the label, so edits
+// above it do not move them; lines of an included or called file are
+// matched as they are, since only edits to that file can shift them. The
+// result is the first instruction of the same file at or after that line
+// within the same label; if the label is gone, the whole program is
+// searched by absolute line.
+std::size_t MapProgramCounter(const std::vector<scenario::Instruction> &oldProgram,
+                              std::size_t oldPc,
+                              const std::vector<scenario::Instruction> &newProgram,
+                              const std::unordered_map<std::string, std::size_t> &newLabels);
+
+}  // namespace cereka
@@ -0,0 +1,243 @@
+#include "image_loader.hpp"
+#include "archive/crtex.hpp"
+#include "asset_pack.hpp"
+
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace cereka::image_loader {
+
+namespace {
+
+// Source texels covered by one destination texel along an axis, with the
+// fraction of each texel that falls inside the destination footprint.
+struct Span {
+    int first = 0;
+    std::vector<float> weights;
+};
+
+std::vector<Span> buildAreaSpans(int srcLen,
+                                 int dstLen)
+{
+    std::vector<Span> spans(dstLen);
+    const double scale = (double)srcLen / (double)dstLen;
+    for (int d = 0; d < dstLen; ++d) {
+        double lo = d * scale;
+        double hi = std::min((d + 1) * scale, (double)srcLen);
+        int first = (int)std::floor(lo);
+        int last = std::min((int)std::ceil(hi), srcLen) - 1;
+        Span &span = spans[d];
+        span.first = first;
+        for (int s = first; s <= last; ++s) {
+            double cover = std::min(hi, (double)(s + 1)) - std::max(lo, (double)s);
+            span.weights.push_back((float)(cover / scale));
+        }
+    }
+    return spans;
+}
+
+SDL_Surface *surfaceFromCrtex(const std::uint8_t *data,
+                              std::size_t size,
+                              const std::string &path)
+{
+    crtex::Header header;
+    if (!crtex::ReadHeader(data, size, header)) {
+        std::cerr << "[CEREKA] Corrupt pre-decoded image: " << path << "\n";
+        return nullptr;
+    }
+    SDL_Surface *surf =
+        SDL_CreateSurface((int)header.width, (int)header.height, SDL_PIXELFORMAT_RGBA32);
+    if (!surf)
+        return nullptr;
+    if (!crtex::DecodePixels(data, size, (std::uint8_t *)surf->pixels, surf->pitch)) {
+        std::cerr << "[CEREKA] Corrupt pre-decoded image: " << path << "\n";
+        SDL_DestroySurface(surf);
+        return nullptr;
+    }
+    return surf;
+}
+
+// Packaged games carry a pre-decoded copy next to each image; loading it is
+// a copy (or LZ4 inflate) straight into the surface.
+SDL_Surface *loadPredecoded(const std::string &path)
+{
+    const std::uint8_t *data = nullptr;
+    std::size_t size = 0;
+    if (!asset_pack::Map(path + crtex::EXTENSION, data, size))
+        return nullptr;
+    return surfaceFromCrtex(data, size, path);
+}
+
+// A .crtex named directly (save thumbnails), which SDL_image cannot read.
+SDL_Surface *loadCrtexFile(const std::string &path)
+{
+    SDL_IOStream *io = asset_pack::Open(path);
+    if (!io)
+        return nullptr;
+    size_t size = 0;
+    void *data = SDL_LoadFile_IO(io, &size, true);
+    if (!data)
+        return nullptr;
+    SDL_Surface *surf = surfaceFromCrtex((const std::uint8_t *)data, size, path);
+    SDL_free(data);
+    return surf;
+}
+
+SDL_Surface *decode(const std::string &path)
+{
+    if (path.ends_with(crtex::EXTENSION))
+        return loadCrtexFile(path);
+    if (SDL_Surface *surf = loadPredecoded(path))
+        return surf;
+    SDL_IOStream *io = asset_pack::Open(path);
+    if (!io)
+        return nullptr;
+    return IMG_Load_IO(io, true);
+}
+
+}  // namespace
+
+void FitSize(int srcW,
+             int srcH,
+             int maxW,
+             int maxH,
+             int &outW,
+             int &outH)
+{
+    outW = srcW;
+    outH = srcH;
+    if (srcW <= 0 || srcH <= 0)
+        return;
+
+    if (maxW > 0 && maxH > 0) {
+        outW = std::min(srcW, maxW);
+        outH = std::min(srcH, maxH);
+    }
+    else if (maxH > 0 && srcH > maxH) {
+        outH = maxH;
+        outW = std::max(1, (int)std::lround((double)srcW * maxH / srcH));
+    }
+    else if (maxW > 0 && srcW > maxW) {
+        outW = maxW;
+        outH = std::max(1, (int)std::lround((double)srcH * maxW / srcW));
+    }
+}
+
+void ResampleArea(const Uint8 *src,
+                  int srcW,
+                  int srcH,
+                  int srcPitch,
+                  Uint8 *dst,
+                  int dstW,
+                  int dstH,
+                  int dstPitch)
+{
+    const std::vector<Span> xSpans = buildAreaSpans(srcW, dstW);
+    const std::vector<Span> ySpans = buildAreaSpans(srcH, dstH);
+
+    // Horizontal pass into a premultiplied float buffer (dstW x srcH).
+    std::vector<float> rows((size_t)dstW * srcH * 4);
+    for (int y = 0; y < srcH; ++y) {
+        const Uint8 *in = src + (size_t)y * srcPitch;
+        float *out = rows.data() + (size_t)y * dstW * 4;
+        for (int x = 0; x < dstW; ++x) {
+            const Span &span = xSpans[x];
+            float r = 0, g = 0, b = 0, a = 0;
+            for (size_t k = 0; k < span.weights.size(); ++k) {
+                const Uint8 *p = in + (size_t)(span.first + k) * 4;
+                float wa = span.weights[k] * (p[3] / 255.0f);
+                r += p[0] * wa;
+                g += p[1] * wa;
+                b += p[2] * wa;
+                a += wa;
+            }
+            out[x * 4 + 0] = r;
+            out[x * 4 + 1] = g;
+            out[x * 4 + 2] = b;
+            out[x * 4 + 3] = a;
+        }
+    }
+
+    // Vertical pass, then un-premultiply back to 8-bit straight alpha.
+    for (int y = 0; y < dstH; ++y) {
+        const Span &span = ySpans[y];
+        Uint8 *out = dst + (size_t)y * dstPitch;
+        for (int x = 0; x < dstW; ++x) {
+            float r = 0, g = 0, b = 0, a = 0;
+            for (size_t k = 0; k < span.weights.size(); ++k) {
+                const float *p = rows.data() + ((size_t)(span.first + k) * dstW + x) * 4;
+                float w = span.weights[k];
+                r += p[0] * w;
+                g += p[1] * w;
+                b += p[2] * w;
+                a += p[3] * w;
+            }
+            Uint8 *q = out + (size_t)x * 4;
+            if (a <= 0.0f) {
+                q[0] = q[1] = q[2] = q[3] = 0;
+                continue;
+            }
+            q[0] = (Uint8)std::clamp(r / a + 0.5f, 0.0f, 255.0f);
+            q[1] = (Uint8)std::clamp(g / a + 0.5f, 0.0f, 255.0f);
+            q[2] = (Uint8)std::clamp(b / a + 0.5f, 0.0f, 255.0f);
+            q[3] = (Uint8)std::clamp(a * 255.0f + 0.5f, 0.0f, 255.0f);
+        }
+    }
+}
+
+SDL_Surface *LoadSurface(const std::string &path,
+                         int maxW,
+                         int maxH)
+{
+    SDL_Surface *loaded = decode(path);
+    if (!loaded)
+        return nullptr;
+
+    int dstW = 0, dstH = 0;
+    FitSize(loaded->w, loaded->h, maxW, maxH, dstW, dstH);
+    if (dstW == loaded->w && dstH == loaded->h)
+        return loaded;
+
+    SDL_Surface *rgba = loaded;
+    if (loaded->format != SDL_PIXELFORMAT_RGBA32) {
+        rgba = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!rgba)
+            return nullptr;
+    }
+
+    SDL_Surface *scaled = SDL_CreateSurface(dstW, dstH, SDL_PIXELFORMAT_RGBA32);
+    if (!scaled) {
+        SDL_DestroySurface(rgba);
+        return nullptr;
+    }
+
+    ResampleArea((const Uint8 *)rgba->pixels,
+                 rgba->w,
+                 rgba->h,
+                 rgba->pitch,
+                 (Uint8 *)scaled->pixels,
+                 dstW,
+                 dstH,
+                 scaled->pitch);
+    SDL_DestroySurface(rgba);
+    return scaled;
+}
+
+SDL_Texture *LoadTexture(SDL_Renderer *renderer,
+                         const std::string &path,
+                         int maxW,
+                         int maxH)
+{
+    SDL_Surface *surf = LoadSurface(path, maxW, maxH);
+    if (!surf)
+        return nullptr;
+    SDL_Texture *tex = SDL_CreateTextureFromSurface(renderer, surf);
+    SDL_DestroySurface(surf);
+    return tex;
+}
+
+}  // namespace cereka::image_loader
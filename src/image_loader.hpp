@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <string>
+
+namespace cereka::image_loader {
+
+/**
+ * Decode an image and upload it no larger than it will be displayed.
+ *
+ * If the source exceeds maxW x maxH it is resampled down on the CPU with an
+ * area (box) filter before upload, so VRAM holds only the visible pixels.
+ * A zero axis is derived from the other one preserving aspect ratio; two
+ * non-zero axes are fitted independently (for images stretched to a rect).
+ * Images are never upscaled. Returns nullptr on failure (SDL_GetError set).
+ */
+SDL_Texture *LoadTexture(SDL_Renderer *renderer,
+                         const std::string &path,
+                         int maxW,
+                         int maxH);
+
+/**
+ * CPU half of LoadTexture: decode and downscale into an RGBA surface without
+ * touching the renderer, so it is safe to call from worker threads.
+ * The caller owns the returned surface.
+ */
+SDL_Surface *LoadSurface(const std::string &path,
+                         int maxW,
+                         int maxH);
+
+/**
+ * Compute the upload size for a srcW x srcH image under the LoadTexture rules.
+ */
+void FitSize(int srcW,
+             int srcH,
+             int maxW,
+             int maxH,
+             int &outW,
+             int &outH);
+
+/**
+ * Area-average downscale of tightly or loosely packed RGBA32 pixels.
+ *
+ * Averaging is done on premultiplied colour so transparent texels do not
+ * bleed dark fringes into sprite edges. dstW/dstH must not exceed srcW/srcH.
+ */
+void ResampleArea(const Uint8 *src,
+                  int srcW,
+                  int srcH,
+                  int srcPitch,
+                  Uint8 *dst,
+                  int dstW,
+                  int dstH,
+                  int dstPitch);
+
+}  // namespace cereka::image_loader
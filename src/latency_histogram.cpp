@@ -0,0 +1,108 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace cereka {
+
+namespace {
+
+// Microseconds at the bottom of the first octave
+constexpr int MIN_SHIFT = 10;  // 1024 us
+
+std::uint64_t lowerUs(int bucket)
+{
+    if (bucket <= 0)
+        return 0;
+    int octave = (bucket - 1) / LatencyHistogram::SUB_BUCKETS;
+    int sub = (bucket - 1) % LatencyHistogram::SUB_BUCKETS;
+    return (std::uint64_t)(LatencyHistogram::SUB_BUCKETS + sub) << (octave + MIN_SHIFT - 4);
+}
+
+}  // namespace
+
+void LatencyHistogram::Record(std::uint64_t ns)
+{
+    ++buckets[BucketOf(ns)];
+    ++count;
+    sumNs += ns;
+    maxNs = std::max(maxNs, ns);
+}
+
+double LatencyHistogram::MeanMs() const
+{
+    return count ? (double)sumNs / (double)count / 1e6 : 0.0;
+}
+
+double LatencyHistogram::PercentileMs(double p) const
+{
+    if (count == 0)
+        return 0.0;
+    auto rank = (std::uint64_t)std::ceil(std::clamp(p, 0.0, 1.0) * (double)count);
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank)
+            return std::min(BucketUpperMs(b), MaxMs());
+    }
+    return MaxMs();
+}
+
+int LatencyHistogram::BucketOf(std::uint64_t ns)
+{
+    std::uint64_t us = ns / 1000;
+    if (us < (1u << MIN_SHIFT))
+        return 0;
+    int octave = std::bit_width(us) - 1 - MIN_SHIFT;
+    if (octave >= OCTAVES)
+        return BUCKETS - 1;
+    // The four bits below the leading one pick the sub-bucket.
+    int sub = (int)(us >> (octave + MIN_SHIFT - 4)) & (SUB_BUCKETS - 1);
+    return 1 + octave * SUB_BUCKETS + sub;
+}
+
+double LatencyHistogram::BucketLowerMs(int bucket)
+{
+    return lowerUs(bucket) / 1e3;
+}
+
+double LatencyHistogram::BucketUpperMs(int bucket)
+{
+    if (bucket >= BUCKETS - 1)
+        return std::numeric_limits<double>::infinity();
+    return lowerUs(bucket + 1) / 1e3;
+}
+
+std::string LatencyHistogram::Report() const
+{
+    char line[160];
+    std::snprintf(line,
+                  sizeof(line),
+                  "input latency: %llu samples, mean %.1f ms, p50 %.1f, p95 %.1f, p99 %.1f, "
+                  "max %.1f ms",
+                  (unsigned long long)count,
+                  MeanMs(),
+                  PercentileMs(0.50),
+                  PercentileMs(0.95),
+                  PercentileMs(0.99),
+                  MaxMs());
+    std::string out = line;
+    for (int b = 0; b < BUCKETS; ++b) {
+        if (buckets[b] == 0)
+            continue;
+        if (b == BUCKETS - 1)
+            std::snprintf(line, sizeof(line), "\n  >= %7.2f ms  %llu", BucketLowerMs(b),
+                          (unsigned long long)buckets[b]);
+        else
+            std::snprintf(line, sizeof(line), "\n  %7.2f - %7.2f ms  %llu", BucketLowerMs(b),
+                          BucketUpperMs(b), (unsigned long long)buckets[b]);
+        out += line;
+    }
+    return out;
+}
+
+}  // namespace cereka
@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace cereka {
+
+// Distribution of input-to-present latencies.
+//
+// Buckets are log-linear: everything under ~1 ms shares the first bucket,
+// then each doubling from 1.024 ms up to ~1 s is split into 16 equal
+// buckets (at most 6.25% wide), and the last bucket takes the rest. That is
+// fine enough to tell a frame of vsync from the next while staying a fixed
+// 162 counters, so recording is a shift and an increment.
+class LatencyHistogram {
+   public:
+    static constexpr int SUB_BUCKETS = 16;  // per doubling
+    static constexpr int OCTAVES = 10;      // 1.024 ms .. 1.048 s
+    static constexpr int BUCKETS = 1 + OCTAVES * SUB_BUCKETS + 1;
+
+    void Record(std::uint64_t ns);
+    void Clear() { *this = {}; }
+
+    std::uint64_t Count() const { return count; }
+    double MeanMs() const;
+    double MaxMs() const { return maxNs / 1e6; }
+    // Upper edge of the bucket holding the p-th fraction (0..1) of samples,
+    // capped at the largest sample. 0 when empty.
+    double PercentileMs(double p) const;
+
+    static int BucketOf(std::uint64_t ns);
+    // Bucket edges in milliseconds; the last bucket's upper edge is infinite.
+    static double BucketLowerMs(int bucket);
+    static double BucketUpperMs(int bucket);
+    std::uint64_t BucketCount(int bucket) const { return buckets[bucket]; }
+
+    // One summary line (count, mean, p50 / p95 / p99, max), then one line
+    // per non-empty bucket.
+    std::string Report() const;
+
+   private:
+    std::array<std::uint64_t, BUCKETS> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t sumNs = 0;
+    std::uint64_t maxNs = 0;
+};
+
+}  // namespace cereka
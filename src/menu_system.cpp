@@ -12,6 +12,7 @@ void MenuSystem::Open(std::vector<std::string> t,
     exits = std::move(ex);
     endPC = end;
     open = true;
+    ++generation;
 }
 
 void MenuSystem::Close()
@@ -22,22 +23,4 @@ void MenuSystem::Close()
     exits.clear();
 }
 
-int MenuSystem::HitTest(int mx,
-                        int my,
-                        int screenW,
-                        int screenH,
-                        float bw,
-                        float bh) const
-{
-    float y = screenH * 0.4f;
-    float x = (float)screenW / 2.0f - bw / 2.0f;
-
-    for (size_t i = 0; i < texts.size(); ++i) {
-        if (mx >= x && mx <= x + bw && my >= y && my <= y + bh)
-            return (int)i;
-        y += bh + 20.0f;
-    }
-    return -1;
-}
-
 }  // namespace cereka
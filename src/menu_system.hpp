@@ -22,12 +22,8 @@ class MenuSystem {
     const std::string &Target(size_t i) const { return targets[i]; }
     bool IsExit(size_t i) const { return exits[i]; }
 
-    int HitTest(int mx,
-                int my,
-                int screenW,
-                int screenH,
-                float buttonW,
-                float buttonH) const;
+    // Bumped by every Open, so a screen can tell a new menu from the last.
+    unsigned Generation() const { return generation; }
 
    private:
     bool open = false;
@@ -35,6 +31,7 @@ class MenuSystem {
     std::vector<std::string> targets;
     std::vector<bool> exits;
     size_t endPC = 0;
+    unsigned generation = 0;
 };
 
 }  // namespace cereka
@@ -1,23 +1,46 @@
 // save.cpp — save/load game state and save/load UI overlay
 
+#include "archive/crtex.hpp"
 #include "engine_impl.hpp"
+#include "image_loader.hpp"
+#include "save_data.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <ctime>
-#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <memory>
 #include <string>
-
-namespace fs = std::filesystem;
+#include <vector>
 
 // ---------------------------------------------------------------------------
 // Internal helpers
 // ---------------------------------------------------------------------------
 
-static std::string savePath(int slot)
+// Last user-visible label at or before pc (the chapter shown in the overlay)
+static std::string currentLabel(const cereka::ScriptInterpreter &si)
+{
+    std::string best;
+    size_t bestPc = 0;
+    for (auto &[name, pc] : si.labelMap) {
+        if (pc > si.pc || name.starts_with("__"))
+            continue;
+        if (best.empty() || pc >= bestPc) {
+            best = name;
+            bestPc = pc;
+        }
+    }
+    return best;
+}
+
+static std::string formatPlaytime(double seconds)
 {
-    return "saves/slot" + std::to_string(slot) + ".sav";
+    int total = (int)seconds;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%d:%02d:%02d", total / 3600, total / 60 % 60, total % 60);
+    return buf;
 }
 
 // Reverse xNorm to position string for serialization
@@ -30,20 +53,34 @@ static std::string xNormToPos(float xNorm)
     return "center";
 }
 
+// Downscale a captured frame to the slot thumbnail and encode it as .crtex.
+// Runs on the save writer thread.
+static std::string encodeThumbnail(SDL_Surface *shot)
+{
+    SDL_Surface *rgba = SDL_ConvertSurface(shot, SDL_PIXELFORMAT_RGBA32);
+    if (!rgba)
+        return {};
+    int w = std::min(rgba->w, cereka::SaveIndex::THUMBNAIL_WIDTH);
+    int h = std::max(1, rgba->h * w / std::max(rgba->w, 1));
+    std::vector<Uint8> pixels((size_t)w * h * 4);
+    cereka::image_loader::ResampleArea(
+        (const Uint8 *)rgba->pixels, rgba->w, rgba->h, rgba->pitch, pixels.data(), w, h, w * 4);
+    SDL_DestroySurface(rgba);
+
+    std::vector<std::uint8_t> file;
+    cereka::crtex::Encode(pixels.data(), w, h, w * 4, true, file);
+    return std::string(file.begin(), file.end());
+}
+
 // ---------------------------------------------------------------------------
-// SaveGame
+// SaveGame — snapshot on this thread, write on the save writer's
 // ---------------------------------------------------------------------------
 
 bool Impl::SaveGame(int slot)
 {
-    std::error_code ec;
-    fs::create_directories("saves", ec);
-
-    std::ofstream f(savePath(slot));
-    if (!f)
+    if (slot < 1)
         return false;
 
-    // Timestamp line (read back by GetSlotTimestamp for the UI)
     auto now = std::chrono::system_clock::now();
     std::time_t t = std::chrono::system_clock::to_time_t(now);
     char tsBuf[32] = {};
@@ -54,40 +91,115 @@ bool Impl::SaveGame(int slot)
     localtime_r(&t, &tmInfo);
 #endif
     strftime(tsBuf, sizeof(tsBuf), "%Y-%m-%d %H:%M", &tmInfo);
-    f << "timestamp=" << tsBuf << "\n";
 
-    f << "pc=" << scriptInterpreter.pc << "\n";
-
-    f << "callstack=";
-    for (size_t i = 0; i < scriptInterpreter.callStack.size(); ++i) {
-        if (i)
-            f << ",";
-        f << scriptInterpreter.callStack[i];
+    SerializableSaveData data = CaptureSaveData();
+    data.timestamp = tsBuf;
+    data.label = currentLabel(scriptInterpreter);
+    data.state = std::to_string((int)states.baseType());  // what the save menu covers
+    data.speaker = dialogue.Speaker();
+    data.name = dialogue.Name();
+    data.text = dialogue.Text();
+    data.displayedChars = dialogue.DisplayedChars();
+
+    // Only the readback happens here; downscale and encode run on the
+    // writer thread, queued ahead of the save that refers to the file.
+    std::string thumbPath = saveIndex.ThumbnailPathOf(slot);
+    if (SDL_Surface *frame = CaptureThumbnail()) {
+        std::shared_ptr<SDL_Surface> shot(frame, SDL_DestroySurface);
+        saveWriter.WriteWith(thumbPath, [shot] { return encodeThumbnail(shot.get()); });
+        data.thumbnail = thumbPath;
     }
-    f << "\n";
-
-    for (auto &[k, v] : scriptInterpreter.variables)
-        f << "var." << k << "=" << v << "\n";
+    for (SlotThumb &t : slotThumbs) {
+        if (t.slot == slot) {
+            textures.Release(t.tex);
+            t = {};
+        }
+    }
+    textures.Evict(thumbPath);
 
-    f << "bg=" << scene.BgPath() << "\n";
+    std::string bytes;
+    if (!saveDataToBinary(data, bytes))
+        return false;
+    saveWriter.Write(saveIndex.PathOf(slot), std::move(bytes));
+
+    SaveIndex::Slot meta;
+    meta.used = true;
+    meta.timestamp = data.timestamp;
+    meta.label = data.label;
+    meta.playtime = data.playtime;
+    meta.thumbnail = data.thumbnail;
+    saveIndex.Put(slot, std::move(meta));
+    return true;
+}
 
+// Script position, variables, scene and music; what a save and an autosave
+// journal record have in common.
+cereka::SerializableSaveData Impl::CaptureSaveData()
+{
+    SerializableSaveData data;
+    data.playtime = playtime;
+    data.programCounter = scriptInterpreter.pc;
+    data.callStack = scriptInterpreter.callStack;
+    data.variables = scriptInterpreter.variables;
+    data.background = scene.BgPath();
+
+    const auto &chars = scene.Characters();
     for (auto &[id, filename] : scene.CharPaths()) {
-        const auto &chars = scene.Characters();
         auto it = chars.find(id);
         float xn = (it != chars.end()) ? it->second.xNorm : 0.5f;
-        f << "char." << id << "=" << filename << ":" << xNormToPos(xn) << "\n";
+        data.characters.push_back({id, filename, xNormToPos(xn)});
     }
 
-    f << "bgm=" << audio.BgmPath() << "\n";
-    f << "state=" << (int)stateBeforeSaveMenu << "\n";
-    f << "speaker=" << dialogue.Speaker() << "\n";
-    f << "name=" << dialogue.Name() << "\n";
-    f << "text=" << dialogue.Text() << "\n";
-    f << "displayedChars=" << dialogue.DisplayedChars() << "\n";
-    f << "skipMode=" << (scriptInterpreter.skipMode ? 1 : 0) << "\n";
-    f << "skipDepth=" << scriptInterpreter.skipDepth << "\n";
+    data.bgm = audio.BgmTarget();
+    data.skipMode = scriptInterpreter.skipMode;
+    data.skipDepth = scriptInterpreter.skipDepth;
+    return data;
+}
 
-    return true;
+// Render the scene (no UI) into a small target and read it back. The target
+// is twice the thumbnail size so the worker's area filter has detail to
+// average, while the GPU readback stays a fraction of a full frame.
+SDL_Surface *Impl::CaptureThumbnail()
+{
+    if (!renderer || screenWidth <= 0 || screenHeight <= 0)
+        return nullptr;
+    int w = SaveIndex::THUMBNAIL_WIDTH * 2;
+    int h = std::max(1, w * screenHeight / screenWidth);
+    // The height follows the window's aspect, so a resize needs a new target.
+    float tw = 0.0f, th = 0.0f;
+    if (thumbnailTarget && (!SDL_GetTextureSize(thumbnailTarget, &tw, &th) || (int)tw != w ||
+                            (int)th != h))
+    {
+        SDL_DestroyTexture(thumbnailTarget);
+        thumbnailTarget = nullptr;
+    }
+    if (!thumbnailTarget) {
+        thumbnailTarget =
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!thumbnailTarget)
+            return nullptr;
+    }
+
+    SDL_SetRenderTarget(renderer, thumbnailTarget);
+    SDL_SetRenderScale(renderer, (float)w / screenWidth, (float)h / screenHeight);
+    DrawScene();
+    SDL_SetRenderScale(renderer, 1.0f, 1.0f);
+    SDL_Surface *shot = SDL_RenderReadPixels(renderer, nullptr);
+    SDL_SetRenderTarget(renderer, nullptr);
+    return shot;
+}
+
+void Impl::ReleaseSlotThumbs()
+{
+    for (SlotThumb &t : slotThumbs) {
+        textures.Release(t.tex);
+        t = {};
+    }
+    // The overlay's tree drew those textures; it is rebuilt on next open.
+    if (saveUi.Size()) {
+        saveUi.Clear();
+        saveUi.SetLayoutKey(0);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -96,194 +208,270 @@ bool Impl::SaveGame(int slot)
 
 bool Impl::LoadGame(int slot)
 {
-    std::ifstream f(savePath(slot));
+    // A save to this slot may still be on its way to disk.
+    saveWriter.Flush();
+
+    std::ifstream f(saveIndex.PathOf(slot), std::ios::binary);
     if (!f)
         return false;
+    std::string bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    SerializableSaveData data;
+    if (!binaryToSaveData(data, bytes)) {
+        std::cerr << "[CEREKA] Unreadable save in slot " << slot << "\n";
+        return false;
+    }
+
+    ApplySaveData(data);
+    return true;
+}
 
-    // Tear down current visual/audio state
-    scene.Clear();
-    audio.StopBGM();
+void Impl::ApplySaveData(const SerializableSaveData &data)
+{
     scriptInterpreter.variables.clear();
     scriptInterpreter.numVariables.clear();
-    scriptInterpreter.callStack.clear();
     dialogue.Clear();
-    scriptInterpreter.skipMode = false;
-    scriptInterpreter.skipDepth = 0;
 
-    std::string line;
-    while (std::getline(f, line)) {
-        auto eq = line.find('=');
-        if (eq == std::string::npos)
-            continue;
-        std::string key = line.substr(0, eq);
-        std::string val = line.substr(eq + 1);
-
-        if (key == "pc") {
-            scriptInterpreter.pc = (size_t)std::stoull(val);
-        }
-        else if (key == "callstack") {
-            if (!val.empty()) {
-                std::istringstream ss(val);
-                std::string tok;
-                while (std::getline(ss, tok, ','))
-                    if (!tok.empty())
-                        scriptInterpreter.callStack.push_back((size_t)std::stoull(tok));
-            }
-        }
-        else if (key.size() > 4 && key.substr(0, 4) == "var.") {
-            std::string varkey = key.substr(4);
-            scriptInterpreter.variables[varkey] = val;
-            try {
-                scriptInterpreter.numVariables[varkey] = std::stof(val);
-            }
-            catch (...) {
-            }
-        }
-        else if (key == "bg") {
-            if (!val.empty())
-                scene.ShowBackground(val);
-        }
-        else if (key.size() > 5 && key.substr(0, 5) == "char.") {
-            std::string id = key.substr(5);
-            // val = "filename.png:left|center|right"
-            auto colon = val.rfind(':');
-            if (colon != std::string::npos) {
-                std::string fname = val.substr(0, colon);
-                std::string pos = val.substr(colon + 1);
-                scene.ShowCharacter(id, fname, pos);
-            }
-        }
-        else if (key == "bgm") {
-            if (!val.empty())
-                audio.PlayBGM(val);
-        }
-        else if (key == "state") {
-            state = (CerekaState)std::stoi(val);
-        }
-        else if (key == "speaker") {
-            dialogue.SetSpeaker(val);
-        }
-        else if (key == "name") {
-            dialogue.SetName(val);
-        }
-        else if (key == "text") {
-            dialogue.SetText(val);
+    playtime = data.playtime;
+    scriptInterpreter.pc = data.programCounter;
+    scriptInterpreter.callStack = data.callStack;
+    for (auto &[key, val] : data.variables) {
+        scriptInterpreter.variables[key] = val;
+        try {
+            scriptInterpreter.numVariables[key] = std::stof(val);
         }
-        else if (key == "displayedChars") {
-            dialogue.SetDisplayedChars(std::stoi(val));
-        }
-        else if (key == "skipMode") {
-            scriptInterpreter.skipMode = (val == "1");
-        }
-        else if (key == "skipDepth") {
-            scriptInterpreter.skipDepth = std::stoi(val);
+        catch (...) {
         }
     }
 
-    return true;
+    // Only what differs from the resident scene is loaded, so loading a
+    // save taken in the current scene touches no files and the music
+    // plays on.
+    std::vector<SceneManager::CharacterPlacement> chars;
+    chars.reserve(data.characters.size());
+    for (const auto &c : data.characters)
+        chars.push_back({c.id, c.file, c.position});
+    scene.Restore(data.background, chars);
+    audio.RestoreBGM(data.bgm);
+
+    // The load menu this was picked from closes with the load.
+    states.clearOverlays();
+    try {
+        auto saved = (CerekaState)std::stoi(data.state);
+        if (EngineStates::isState(saved) && !EngineStates::isOverlay(saved))
+            states.changeState(saved);
+    }
+    catch (...) {
+    }
+    dialogue.SetSpeaker(data.speaker);
+    dialogue.SetName(data.name);
+    dialogue.SetText(data.text);
+    dialogue.SetDisplayedChars(data.displayedChars);
+    scriptInterpreter.skipMode = data.skipMode;
+    scriptInterpreter.skipDepth = data.skipDepth;
 }
 
 // ---------------------------------------------------------------------------
-// GetSlotTimestamp — reads just the first line of a save file
+// Autosave journal
 // ---------------------------------------------------------------------------
 
-std::string Impl::GetSlotTimestamp(int slot)
+// Called when the VM stops for the player at pc. Resuming re-runs that
+// instruction, so the dialogue and the wait state are not journaled.
+void Impl::Autosave(size_t pc)
 {
-    std::ifstream f(savePath(slot));
-    if (!f)
-        return "";
-    std::string line;
-    if (std::getline(f, line)) {
-        auto eq = line.find('=');
-        if (eq != std::string::npos && line.substr(0, eq) == "timestamp")
-            return line.substr(eq + 1);
+    SerializableSaveData data = CaptureSaveData();
+    data.programCounter = pc;
+    journal.Record(std::move(data));
+}
+
+bool Impl::ResumeAutosave()
+{
+    using scenario::Op;
+
+    journal.Flush();
+    SerializableSaveData data;
+    if (!SaveJournal::Replay(journal.Path(), data))
+        return false;
+
+    // Journaled pcs always point at the instruction that waited for input;
+    // anything else means the script changed since.
+    const auto &program = scriptInterpreter.program;
+    if (data.programCounter >= program.size() ||
+        (program[data.programCounter].op != Op::SAY &&
+         program[data.programCounter].op != Op::NARRATE &&
+         program[data.programCounter].op != Op::MENU))
+    {
+        std::cerr << "[CEREKA] Autosave does not match the loaded script; starting over\n";
+        return false;
     }
-    return "???";
+
+    ApplySaveData(data);
+    states.changeState(CerekaState::Running);
+    return true;
 }
 
 // ---------------------------------------------------------------------------
-// DrawSaveLoadOverlay — SDL3-rendered overlay (no ImGui)
+// DrawSaveLoadOverlay — one page of slots on the save widget tree
 // ---------------------------------------------------------------------------
 
-void Impl::DrawSaveLoadOverlay(bool isSaving)
+namespace {
+
+// Widget ids of the pager buttons; slot buttons use their slot number (>= 1).
+constexpr int PREV_PAGE_ID = -2;
+constexpr int NEXT_PAGE_ID = -3;
+
+// Widgets are added panel, title, then a button + thumbnail per row.
+constexpr int THUMB_WIDGET_0 = 3;
+
+}  // namespace
+
+void Impl::BuildSaveUi(bool isSaving)
 {
+    using ui::Widget;
+
     const float panelW = screenWidth * 0.5f;
     const float panelH = screenHeight * 0.8f;
     const float panelX = (screenWidth - panelW) * 0.5f;
     const float panelY = (screenHeight - panelH) * 0.5f;
-    const float slotH = (panelH - 60.0f) / 10.0f;
-
-    // Dim background
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
-    SDL_RenderFillRect(renderer, nullptr);
-
-    // Panel background
-    SDL_SetRenderDrawColor(renderer, 20, 22, 38, 230);
-    SDL_FRect panel{panelX, panelY, panelW, panelH};
-    SDL_RenderFillRect(renderer, &panel);
-
-    // Title
-    SDL_Texture *titleTex = RenderText(isSaving ? "SAVE GAME" : "LOAD GAME", {180, 200, 255, 255});
-    if (titleTex) {
-        float tw, th;
-        SDL_GetTextureSize(titleTex, &tw, &th);
-        SDL_FRect dst{panelX + (panelW - tw) * 0.5f, panelY + 8.0f, tw, th};
-        SDL_RenderTexture(renderer, titleTex, nullptr, &dst);
-        SDL_DestroyTexture(titleTex);
-    }
+    const float footerH = 36.0f;
+    const float slotH = (panelH - 50.0f - footerH) / SaveIndex::SLOTS_PER_PAGE;
+
+    savePage = std::clamp(savePage, 0, saveIndex.PageCount() - 1);
+    const int firstSlot = SaveIndex::FirstSlotOfPage(savePage);
+
+    std::uint64_t key = ui::WidgetTree::KeyOf({themeVersion,
+                                               (std::uint64_t)screenWidth,
+                                               (std::uint64_t)screenHeight,
+                                               isSaving,
+                                               (std::uint64_t)savePage,
+                                               (std::uint64_t)saveIndex.PageCount()});
+    if (saveUi.LayoutKey() != key) {
+        saveUi.Clear();
+        saveUi.SetLayoutKey(key);
+
+        Widget panel;
+        panel.rect = {panelX, panelY, panelW, panelH};
+        panel.style.fill = {20, 22, 38, 230};
+        saveUi.Add(panel);
+
+        Widget title;
+        title.kind = Widget::Kind::Label;
+        title.rect = {panelX, panelY, panelW, 50.0f};
+        title.alignY = Widget::Align::Start;
+        title.padY = 8.0f;
+        title.text = isSaving ? "SAVE GAME" : "LOAD GAME";
+        title.style.text = {180, 200, 255, 255};
+        saveUi.Add(title);
+
+        for (int row = 0; row < SaveIndex::SLOTS_PER_PAGE; ++row) {
+            const int i = firstSlot + row;
+            const SaveIndex::Slot &meta = saveIndex.Get(i);
+            std::string label = "Slot " + std::to_string(i) + "   ";
+            if (!meta.used)
+                label += "Empty";
+            else {
+                label += meta.timestamp;
+                if (!meta.label.empty())
+                    label += "   " + meta.label;
+                if (meta.playtime > 0.0)
+                    label += "   " + formatPlaytime(meta.playtime);
+            }
 
-    // Slot rows
-    for (int i = 1; i <= 10; ++i) {
-        float slotY = panelY + 50.0f + (i - 1) * slotH;
-        SDL_FRect slotRect{panelX + 10.0f, slotY + 2.0f, panelW - 20.0f, slotH - 4.0f};
+            Widget slot;
+            slot.kind = Widget::Kind::Button;
+            slot.id = i;
+            slot.rect = {
+                panelX + 10.0f, panelY + 50.0f + row * slotH + 2.0f, panelW - 20.0f, slotH - 4.0f};
+            slot.style.fill = {40, 44, 66, 210};
+            slot.style.text =
+                meta.used ? SDL_Color{220, 220, 220, 255} : SDL_Color{100, 100, 100, 255};
+            slot.text = label;
+            slot.alignX = Widget::Align::Start;
+            slot.padX = 10.0f;
+            int slotIndex = saveUi.Add(slot);
+
+            // Placed once its texture is loaded (below)
+            Widget thumb;
+            thumb.parent = slotIndex;
+            saveUi.Add(thumb);
+        }
 
-        SDL_SetRenderDrawColor(renderer, 40, 44, 66, 210);
-        SDL_RenderFillRect(renderer, &slotRect);
+        const float footerY = panelY + panelH - footerH;
+        Widget prev;
+        prev.kind = Widget::Kind::Button;
+        prev.id = PREV_PAGE_ID;
+        prev.rect = {panelX + 10.0f, footerY + 4.0f, 60.0f, footerH - 8.0f};
+        prev.style.fill = {40, 44, 66, 210};
+        prev.text = "<";
+        saveUi.Add(prev);
+
+        Widget hint;
+        hint.kind = Widget::Kind::Label;
+        hint.rect = {panelX + 70.0f, footerY, panelW - 140.0f, footerH};
+        hint.text = "Page " + std::to_string(savePage + 1) + " / " +
+                    std::to_string(saveIndex.PageCount()) + "      ESC to cancel";
+        hint.style.text = {120, 120, 120, 255};
+        hint.shrinkToFit = true;
+        saveUi.Add(hint);
+
+        Widget next = prev;
+        next.id = NEXT_PAGE_ID;
+        next.rect.x = panelX + panelW - 70.0f;
+        next.text = ">";
+        saveUi.Add(next);
+    }
 
-        std::string ts = GetSlotTimestamp(i);
-        std::string label = "Slot " + std::to_string(i) + "   " + (ts.empty() ? "Empty" : ts);
+    // Thumbnails at the right end of each row, once their file is on disk
+    for (int row = 0; row < SaveIndex::SLOTS_PER_PAGE; ++row) {
+        const int i = firstSlot + row;
+        const SaveIndex::Slot &meta = saveIndex.Get(i);
+        SlotThumb &thumb = slotThumbs[row];
+        if (thumb.slot != i) {
+            textures.Release(thumb.tex);
+            thumb = {i};
+        }
+        if (!thumb.tried && !meta.thumbnail.empty() && !saveWriter.Pending(meta.thumbnail)) {
+            thumb.tex = textures.Acquire({AssetPrefetcher::Request::Kind::Image, meta.thumbnail});
+            thumb.tried = true;
+        }
 
-        SDL_Texture *slotTex = RenderText(
-            label, ts.empty() ? SDL_Color{100, 100, 100, 255} : SDL_Color{220, 220, 220, 255});
-        if (slotTex) {
+        const int w = THUMB_WIDGET_0 + 2 * row;
+        if (thumb.tex) {
+            const SDL_FRect &slotRect = saveUi.At(w - 1).rect;
             float tw, th;
-            SDL_GetTextureSize(slotTex, &tw, &th);
-            SDL_FRect dst{slotRect.x + 10.0f, slotY + (slotH - th) * 0.5f, tw, th};
-            SDL_RenderTexture(renderer, slotTex, nullptr, &dst);
-            SDL_DestroyTexture(slotTex);
+            SDL_GetTextureSize(thumb.tex, &tw, &th);
+            float dh = slotRect.h - 4.0f;
+            float dw = th > 0.0f ? dh * tw / th : 0.0f;
+            saveUi.SetRect(w, {slotRect.x + slotRect.w - dw - 2.0f, slotRect.y + 2.0f, dw, dh});
         }
-    }
-
-    // ESC hint
-    SDL_Texture *hintTex = RenderText("ESC to cancel", {120, 120, 120, 255});
-    if (hintTex) {
-        float tw, th;
-        SDL_GetTextureSize(hintTex, &tw, &th);
-        SDL_FRect dst{panelX + (panelW - tw) * 0.5f, panelY + panelH - th - 8.0f, tw, th};
-        SDL_RenderTexture(renderer, hintTex, nullptr, &dst);
-        SDL_DestroyTexture(hintTex);
+        saveUi.SetImage(w, thumb.tex);
     }
 }
 
-// ---------------------------------------------------------------------------
-// HitTestSaveSlot — returns slot 1-10 or -1
-// ---------------------------------------------------------------------------
-
-int Impl::HitTestSaveSlot(int mx,
-                          int my)
+void Impl::DrawSaveLoadOverlay(bool isSaving)
 {
-    const float panelW = screenWidth * 0.5f;
-    const float panelH = screenHeight * 0.8f;
-    const float panelX = (screenWidth - panelW) * 0.5f;
-    const float panelY = (screenHeight - panelH) * 0.5f;
-    const float slotH = (panelH - 60.0f) / 10.0f;
+    BuildSaveUi(isSaving);
+    saveUi.Draw(screenWidth, screenHeight);
+}
 
-    for (int i = 1; i <= 10; ++i) {
-        float slotY = panelY + 50.0f + (i - 1) * slotH;
-        if ((float)mx >= panelX + 10.0f && (float)mx <= panelX + panelW - 10.0f &&
-            (float)my >= slotY + 2.0f && (float)my <= slotY + slotH - 2.0f)
-            return i;
+// A slot or pager button was clicked or chosen with the keyboard.
+void Impl::ActivateSaveWidget(int id,
+                              bool isSaving)
+{
+    if (id == PREV_PAGE_ID)
+        TurnSavePage(-1);
+    else if (id == NEXT_PAGE_ID)
+        TurnSavePage(1);
+    else if (id >= 1 && isSaving) {
+        SaveGame(id);
+        states.popOverlay();
     }
-    return -1;
+    else if (id >= 1)
+        LoadGame(id);  // restores state from file
+}
+
+void Impl::TurnSavePage(int delta)
+{
+    // The last page always has at least one free slot to page onto.
+    savePage = std::clamp(savePage + delta, 0, saveIndex.PageCount() - 1);
 }
@@ -0,0 +1,195 @@
+// save_data.cpp — binary save encoding, version migration, the legacy
+// key=value reader and autosave journal deltas
+
+#include "save_data.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+
+namespace cereka {
+
+namespace {
+
+constexpr char MAGIC[4] = {'C', 'R', 'S', 'V'};
+constexpr std::size_t HEADER_SIZE = 8;
+
+// Version 0 is the key=value text format written before saves were binary.
+// MIGRATIONS[v] upgrades data read from a version-v save to version v + 1.
+using Migration = void (*)(SerializableSaveData &);
+
+void fromTextSave(SerializableSaveData &)
+{
+    // Text saves already parse into the version 1 layout; label, playtime
+    // and thumbnail are simply absent.
+}
+
+constexpr Migration MIGRATIONS[] = {
+    fromTextSave,  // 0 -> 1
+};
+static_assert(std::size(MIGRATIONS) == SAVE_VERSION, "one migration per older version");
+
+bool migrate(SerializableSaveData &data,
+             std::uint32_t from)
+{
+    if (from > SAVE_VERSION)
+        return false;  // written by a newer engine
+    for (std::uint32_t v = from; v < SAVE_VERSION; ++v)
+        MIGRATIONS[v](data);
+    data.version = SAVE_VERSION;
+    return true;
+}
+
+bool textToSaveData(SerializableSaveData &data,
+                    const std::string &text)
+{
+    data = SerializableSaveData{};
+    std::istringstream in(text);
+    std::string line;
+    bool any = false;
+    try {
+        while (std::getline(in, line)) {
+            auto eq = line.find('=');
+            if (eq == std::string::npos)
+                continue;
+            any = true;
+            std::string key = line.substr(0, eq);
+            std::string val = line.substr(eq + 1);
+
+            if (key == "timestamp")
+                data.timestamp = val;
+            else if (key == "label")
+                data.label = val;
+            else if (key == "playtime")
+                data.playtime = std::stod(val);
+            else if (key == "pc")
+                data.programCounter = (size_t)std::stoull(val);
+            else if (key == "callstack") {
+                std::istringstream ss(val);
+                std::string tok;
+                while (std::getline(ss, tok, ','))
+                    if (!tok.empty())
+                        data.callStack.push_back((size_t)std::stoull(tok));
+            }
+            else if (key.size() > 4 && key.substr(0, 4) == "var.")
+                data.variables[key.substr(4)] = val;
+            else if (key == "bg")
+                data.background = val;
+            else if (key.size() > 5 && key.substr(0, 5) == "char.") {
+                // val = "filename.png:left|center|right"
+                auto colon = val.rfind(':');
+                if (colon != std::string::npos)
+                    data.characters.push_back(
+                        {key.substr(5), val.substr(0, colon), val.substr(colon + 1)});
+            }
+            else if (key == "bgm")
+                data.bgm = val;
+            else if (key == "state")
+                data.state = val;
+            else if (key == "speaker")
+                data.speaker = val;
+            else if (key == "name")
+                data.name = val;
+            else if (key == "text")
+                data.text = val;
+            else if (key == "displayedChars")
+                data.displayedChars = std::stoi(val);
+            else if (key == "skipMode")
+                data.skipMode = (val == "1");
+            else if (key == "skipDepth")
+                data.skipDepth = std::stoi(val);
+        }
+    }
+    catch (...) {
+        return false;
+    }
+    return any;
+}
+
+}  // namespace
+
+bool saveDataToBinary(const SerializableSaveData &data,
+                      std::string &bytesOut)
+{
+    SerializableSaveData versioned = data;
+    versioned.version = SAVE_VERSION;
+    auto payload = glz::write_beve(versioned);
+    if (!payload)
+        return false;
+
+    bytesOut.assign(MAGIC, sizeof(MAGIC));
+    for (int i = 0; i < 4; ++i)
+        bytesOut.push_back((char)((SAVE_VERSION >> (8 * i)) & 0xff));
+    bytesOut += *payload;
+    return true;
+}
+
+bool binaryToSaveData(SerializableSaveData &data,
+                      const std::string &bytes)
+{
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0)
+        return textToSaveData(data, bytes) && migrate(data, 0);
+
+    std::uint32_t version = 0;
+    for (int i = 0; i < 4; ++i)
+        version |= (std::uint32_t)(unsigned char)bytes[4 + i] << (8 * i);
+    if (version == 0 || version > SAVE_VERSION)
+        return false;
+
+    // Tolerate keys this build does not know so saves from builds that only
+    // added fields still load.
+    data = SerializableSaveData{};
+    std::string_view payload(bytes.data() + HEADER_SIZE, bytes.size() - HEADER_SIZE);
+    auto ec = glz::read<glz::opts{.format = glz::BEVE, .error_on_unknown_keys = false}>(data,
+                                                                                       payload);
+    if (ec)
+        return false;
+    return migrate(data, version);
+}
+
+SerializableSaveDelta diffSaveData(const SerializableSaveData &from,
+                                   const SerializableSaveData &to)
+{
+    SerializableSaveDelta d;
+    d.playtime = to.playtime;
+    d.programCounter = to.programCounter;
+    if (to.callStack != from.callStack)
+        d.callStack = to.callStack;
+    for (const auto &[key, val] : to.variables) {
+        auto it = from.variables.find(key);
+        if (it == from.variables.end() || it->second != val)
+            d.setVariables.emplace(key, val);
+    }
+    for (const auto &[key, val] : from.variables)
+        if (!to.variables.count(key))
+            d.erasedVariables.push_back(key);
+    if (to.background != from.background)
+        d.background = to.background;
+    if (to.characters != from.characters)
+        d.characters = to.characters;
+    if (to.bgm != from.bgm)
+        d.bgm = to.bgm;
+    return d;
+}
+
+void applySaveDelta(SerializableSaveData &data,
+                    const SerializableSaveDelta &delta)
+{
+    data.playtime = delta.playtime;
+    data.programCounter = delta.programCounter;
+    if (delta.callStack)
+        data.callStack = *delta.callStack;
+    for (const auto &[key, val] : delta.setVariables)
+        data.variables[key] = val;
+    for (const auto &key : delta.erasedVariables)
+        data.variables.erase(key);
+    if (delta.background)
+        data.background = *delta.background;
+    if (delta.characters)
+        data.characters = *delta.characters;
+    if (delta.bgm)
+        data.bgm = *delta.bgm;
+}
+
+}  // namespace cereka
@@ -1,12 +1,16 @@
 #pragma once
 // save_data.hpp — Glaze-based game save serialization
 //
-// Uses Glaze library for JSON serialization/deserialization of game saves.
+// Save files are a small header ("CRSV" + little-endian format version)
+// followed by the BEVE encoding of SerializableSaveData. JSON is kept for
+// debugging and tooling.
 
 #ifndef CEREKA_SAVE_DATA_HPP
 #    define CEREKA_SAVE_DATA_HPP
 
 #    include <glaze/glaze.hpp>
+#    include <cstdint>
+#    include <optional>
 #    include <string>
 #    include <unordered_map>
 #    include <vector>
@@ -21,14 +25,25 @@ struct SerializableCharacter {
     std::string id;
     std::string file;
     std::string position;
+
+    bool operator==(const SerializableCharacter &) const = default;
 };
 
 // ============================================================================
 // SerializableSaveData — Complete game state for serialization
 // ============================================================================
 
+// Bump when the meaning of a field changes and add a migration for the old
+// version in save_data.cpp. Adding fields needs neither: BEVE objects are
+// keyed, and keys an old save lacks keep their defaults.
+inline constexpr std::uint32_t SAVE_VERSION = 1;
+
 struct SerializableSaveData {
+    std::uint32_t version = SAVE_VERSION;  // version the save was read as (after migration)
     std::string timestamp;
+    std::string label;       // chapter shown in the save/load overlay
+    double playtime = 0.0;   // seconds
+    std::string thumbnail;
     size_t programCounter = 0;
     std::vector<size_t> callStack;
     std::unordered_map<std::string, std::string> variables;
@@ -44,6 +59,28 @@ struct SerializableSaveData {
     int skipDepth = 0;
 };
 
+// ============================================================================
+// SerializableSaveDelta — One autosave journal record
+// ============================================================================
+
+// What changed between two states at interaction points. pc and playtime
+// are always present; everything else only when it differs.
+struct SerializableSaveDelta {
+    double playtime = 0.0;
+    size_t programCounter = 0;
+    std::optional<std::vector<size_t>> callStack;
+    std::unordered_map<std::string, std::string> setVariables;
+    std::vector<std::string> erasedVariables;
+    std::optional<std::string> background;
+    std::optional<std::vector<SerializableCharacter>> characters;
+    std::optional<std::string> bgm;
+};
+
+SerializableSaveDelta diffSaveData(const SerializableSaveData &from,
+                                   const SerializableSaveData &to);
+void applySaveDelta(SerializableSaveData &data,
+                    const SerializableSaveDelta &delta);
+
 // ============================================================================
 // Serialization Functions
 // ============================================================================
@@ -74,6 +111,21 @@ struct SerializableSaveData {
     return false;
 }
 
+/**
+ * Encode a save to its on-disk form. Version and magic are written by this
+ * function; data.version is ignored.
+ */
+[[nodiscard]] bool saveDataToBinary(const SerializableSaveData &data,
+                                    std::string &bytesOut);
+
+/**
+ * Decode anything the engine has written to a save slot: the current
+ * binary format, an older binary version, or the key=value text saves that
+ * predate it. Older saves are migrated to SAVE_VERSION.
+ */
+[[nodiscard]] bool binaryToSaveData(SerializableSaveData &data,
+                                    const std::string &bytes);
+
 }  // namespace cereka
 
 // ============================================================================
@@ -87,20 +139,36 @@ template<> struct glz::meta<cereka::SerializableCharacter> {
 
 template<> struct glz::meta<cereka::SerializableSaveData> {
     using T = cereka::SerializableSaveData;
-    static constexpr auto value = object("timestamp",
-                                         "programCounter",
-                                         "callStack",
-                                         "variables",
-                                         "background",
-                                         "characters",
-                                         "bgm",
-                                         "state",
-                                         "speaker",
-                                         "name",
-                                         "text",
-                                         "displayedChars",
-                                         "skipMode",
-                                         "skipDepth");
+    static constexpr auto value = object(&T::version,
+                                         &T::timestamp,
+                                         &T::label,
+                                         &T::playtime,
+                                         &T::thumbnail,
+                                         &T::programCounter,
+                                         &T::callStack,
+                                         &T::variables,
+                                         &T::background,
+                                         &T::characters,
+                                         &T::bgm,
+                                         &T::state,
+                                         &T::speaker,
+                                         &T::name,
+                                         &T::text,
+                                         &T::displayedChars,
+                                         &T::skipMode,
+                                         &T::skipDepth);
+};
+
+template<> struct glz::meta<cereka::SerializableSaveDelta> {
+    using T = cereka::SerializableSaveDelta;
+    static constexpr auto value = object(&T::playtime,
+                                         &T::programCounter,
+                                         &T::callStack,
+                                         &T::setVariables,
+                                         &T::erasedVariables,
+                                         &T::background,
+                                         &T::characters,
+                                         &T::bgm);
 };
 
 #endif  // CEREKA_SAVE_DATA_HPP
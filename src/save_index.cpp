@@ -0,0 +1,112 @@
+#include "save_index.hpp"
+#include "save_data.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+namespace cereka {
+
+std::string SaveIndex::PathOf(int slot) const
+{
+    return dir + "/slot" + std::to_string(slot) + ".sav";
+}
+
+std::string SaveIndex::ThumbnailPathOf(int slot) const
+{
+    return dir + "/slot" + std::to_string(slot) + ".crtex";
+}
+
+void SaveIndex::scan()
+{
+    if (scanned)
+        return;
+    scanned = true;
+    used.clear();
+
+    // Names only; no save file is opened here.
+    std::error_code ec;
+    for (auto &entry : fs::directory_iterator(dir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (!name.starts_with("slot") || !name.ends_with(".sav"))
+            continue;
+        std::string digits = name.substr(4, name.size() - 8);
+        if (digits.empty() || digits.find_first_not_of("0123456789") != std::string::npos)
+            continue;
+        try {
+            int slot = std::stoi(digits);
+            if (slot >= 1)
+                used.insert(slot);
+        }
+        catch (...) {
+        }
+    }
+}
+
+const SaveIndex::Slot &SaveIndex::Get(int slot)
+{
+    static const Slot empty;
+    if (slot < 1)
+        return empty;
+    auto it = loaded.find(slot);
+    if (it != loaded.end())
+        return it->second;
+
+    scan();
+    if (!used.count(slot))
+        return empty;
+    return loaded.emplace(slot, ReadSlot(PathOf(slot))).first->second;
+}
+
+void SaveIndex::Put(int slot,
+                    Slot info)
+{
+    if (slot < 1)
+        return;
+    scan();
+    used.insert(slot);
+    loaded[slot] = std::move(info);
+}
+
+void SaveIndex::Invalidate()
+{
+    scanned = false;
+    used.clear();
+    loaded.clear();
+}
+
+int SaveIndex::HighestUsed()
+{
+    scan();
+    return used.empty() ? 0 : *used.rbegin();
+}
+
+int SaveIndex::PageCount()
+{
+    return HighestUsed() / SLOTS_PER_PAGE + 1;
+}
+
+SaveIndex::Slot SaveIndex::ReadSlot(const std::string &path)
+{
+    Slot s;
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+        return s;
+    s.used = true;
+
+    std::string bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    SerializableSaveData data;
+    if (!binaryToSaveData(data, bytes)) {
+        s.timestamp = "???";
+        return s;
+    }
+    s.timestamp = data.timestamp.empty() ? "???" : data.timestamp;
+    s.label = data.label;
+    s.playtime = data.playtime;
+    s.thumbnail = data.thumbnail;
+    return s;
+}
+
+}  // namespace cereka
@@ -0,0 +1,63 @@
+#pragma once
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace cereka {
+
+// Per-slot save metadata for any number of slots, shown a page at a time.
+//
+// The save directory is listed once to learn which slots exist; a slot's
+// file is only read when that slot is first displayed, and SaveGame keeps
+// the entry current after that. Drawing the save/load overlay touches no
+// files once a page has been seen, however many saves there are.
+class SaveIndex {
+   public:
+    static constexpr int SLOTS_PER_PAGE = 10;
+    static constexpr int THUMBNAIL_WIDTH = 256;  // height follows the screen aspect
+
+    struct Slot {
+        bool used = false;
+        std::string timestamp;
+        std::string label;       // chapter: last script label before the saved pc
+        double playtime = 0.0;   // seconds
+        std::string thumbnail;   // image path; empty if the save has none
+    };
+
+    explicit SaveIndex(std::string dir = "saves")
+        : dir(std::move(dir))
+    {
+    }
+
+    const std::string &Dir() const { return dir; }
+    std::string PathOf(int slot) const;
+    // Pre-decoded RGBA (.crtex) capture of the scene at save time.
+    std::string ThumbnailPathOf(int slot) const;
+
+    // Slots are numbered from 1; anything lower reads as empty.
+    const Slot &Get(int slot);
+    void Put(int slot,
+             Slot info);
+    // Drop everything; the next call lists the directory again.
+    void Invalidate();
+
+    // 0 when there are no saves.
+    int HighestUsed();
+    // Enough pages to show every save plus at least one free slot.
+    int PageCount();
+    static int FirstSlotOfPage(int page) { return page * SLOTS_PER_PAGE + 1; }
+
+    // Metadata of one save file, binary or legacy text. A missing file
+    // gives an unused slot; an undecodable one a used slot with "???".
+    static Slot ReadSlot(const std::string &path);
+
+   private:
+    void scan();
+
+    std::string dir;
+    bool scanned = false;
+    std::set<int> used;                     // slots with a file on disk
+    std::unordered_map<int, Slot> loaded;  // slots read or saved so far
+};
+
+}  // namespace cereka
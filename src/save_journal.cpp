@@ -0,0 +1,323 @@
+#include "save_journal.hpp"
+#include "save_data.hpp"
+#include "save_writer.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string_view>
+
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cereka {
+
+namespace {
+
+constexpr char MAGIC[4] = {'C', 'R', 'J', 'L'};
+constexpr std::uint32_t JOURNAL_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 8;
+constexpr std::size_t RECORD_HEADER_SIZE = 9;  // size, checksum, kind
+
+void putU32(std::string &out,
+            std::uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+        out.push_back((char)((v >> (8 * i)) & 0xff));
+}
+
+std::uint32_t getU32(const char *p)
+{
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i)
+        v |= (std::uint32_t)(unsigned char)p[i] << (8 * i);
+    return v;
+}
+
+std::uint32_t checksum(unsigned char kind,
+                       std::string_view payload)
+{
+    std::uint32_t h = 2166136261u;
+    h = (h ^ kind) * 16777619u;
+    for (char c : payload)
+        h = (h ^ (unsigned char)c) * 16777619u;
+    return h;
+}
+
+void appendRecord(std::string &out,
+                  unsigned char kind,
+                  const std::string &payload)
+{
+    putU32(out, (std::uint32_t)payload.size());
+    putU32(out, checksum(kind, payload));
+    out.push_back((char)kind);
+    out += payload;
+}
+
+bool syncFile(std::FILE *f)
+{
+    if (std::fflush(f) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+}  // namespace
+
+SaveJournal::SaveJournal(std::string path)
+    : path(std::move(path))
+{
+    SetDeltaEncoder({});
+}
+
+void SaveJournal::SetDeltaEncoder(DeltaEncoder encoder)
+{
+    if (!encoder) {
+        encoder = [](const SerializableSaveDelta &delta) {
+            auto bytes = glz::write_beve(delta);
+            return bytes ? *bytes : std::string();
+        };
+    }
+    encodeDelta = std::move(encoder);
+}
+
+SaveJournal::~SaveJournal()
+{
+    Stop();
+    closeFile();
+}
+
+void SaveJournal::Start()
+{
+    Stop();
+    stopping = false;
+    worker = std::thread([this] { workerLoop(); });
+}
+
+void SaveJournal::Stop()
+{
+    if (!worker.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCv.notify_all();
+    worker.join();
+}
+
+void SaveJournal::Record(SerializableSaveData state)
+{
+    if (!last || sinceSnapshot >= COMPACT_AFTER || broken.exchange(false)) {
+        last = std::make_unique<SerializableSaveData>(std::move(state));
+        queueSnapshot();
+        return;
+    }
+
+    auto delta = std::make_shared<SerializableSaveDelta>(diffSaveData(*last, state));
+    *last = std::move(state);
+    ++sinceSnapshot;
+    push({Kind::Delta, [delta, encode = encodeDelta] { return encode(*delta); }});
+}
+
+void SaveJournal::Compact()
+{
+    if (last && sinceSnapshot > 0)
+        queueSnapshot();
+}
+
+void SaveJournal::Discard()
+{
+    last.reset();
+    sinceSnapshot = 0;
+    push({Kind::Discard, {}});
+}
+
+void SaveJournal::queueSnapshot()
+{
+    auto copy = std::make_shared<SerializableSaveData>(*last);
+    sinceSnapshot = 0;
+    push({Kind::Snapshot, [copy] {
+              std::string bytes;
+              return saveDataToBinary(*copy, bytes) ? bytes : std::string();
+          }});
+}
+
+void SaveJournal::push(Job job)
+{
+    if (!worker.joinable()) {
+        std::deque<Job> one;
+        one.push_back(std::move(job));
+        writeBatch(one);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+    }
+    workCv.notify_one();
+}
+
+void SaveJournal::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    flushing = true;
+    workCv.notify_all();
+    idleCv.wait(lock, [this] { return queue.empty() && !busy; });
+    flushing = false;
+}
+
+void SaveJournal::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workCv.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty())
+            break;
+        // Records arriving shortly after this one (skipping through text)
+        // share its fsync.
+        workCv.wait_for(lock, BATCH_WINDOW, [this] { return stopping || flushing; });
+
+        std::deque<Job> batch;
+        batch.swap(queue);
+        busy = true;
+        lock.unlock();
+
+        writeBatch(batch);
+
+        lock.lock();
+        busy = false;
+        if (queue.empty())
+            idleCv.notify_all();
+    }
+    lock.unlock();
+    closeFile();
+}
+
+void SaveJournal::writeBatch(std::deque<Job> &jobs)
+{
+    bool appended = false;
+    // Every later delta builds on the record that failed, so nothing more
+    // goes into this file; Record starts over with a snapshot.
+    auto breakChain = [&] {
+        if (file && appended)
+            syncFile(file);
+        appended = false;
+        closeFile();
+        broken = true;
+    };
+    for (Job &job : jobs) {
+        if (job.kind == Kind::Discard) {
+            closeFile();
+            std::error_code ec;
+            fs::remove(path, ec);
+            continue;
+        }
+
+        std::string payload = job.encode();
+        if (payload.empty()) {
+            breakChain();
+            continue;
+        }
+
+        if (job.kind == Kind::Snapshot) {
+            closeFile();
+            std::string bytes(MAGIC, sizeof(MAGIC));
+            putU32(bytes, JOURNAL_VERSION);
+            appendRecord(bytes, (unsigned char)Kind::Snapshot, payload);
+            if (!SaveWriter::WriteAtomically(path, bytes)) {
+                std::cerr << "[CEREKA] Failed to write autosave: " << path << "\n";
+                breakChain();
+                continue;
+            }
+            file = std::fopen(path.c_str(), "ab");
+            if (!file)
+                broken = true;
+            continue;
+        }
+
+        // A delta only means something on top of the snapshot it follows.
+        if (!file)
+            continue;
+        std::string record;
+        appendRecord(record, (unsigned char)Kind::Delta, payload);
+        if (std::fwrite(record.data(), 1, record.size(), file) != record.size()) {
+            breakChain();
+            continue;
+        }
+        appended = true;
+    }
+
+    if (appended && file && !syncFile(file)) {
+        closeFile();
+        broken = true;
+    }
+}
+
+void SaveJournal::closeFile()
+{
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool SaveJournal::Replay(const std::string &path,
+                         SerializableSaveData &out)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+        return false;
+    std::string bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        getU32(bytes.data() + 4) != JOURNAL_VERSION)
+        return false;
+
+    bool haveSnapshot = false;
+    SerializableSaveData state;
+    std::size_t pos = HEADER_SIZE;
+    while (bytes.size() - pos >= RECORD_HEADER_SIZE) {
+        std::uint32_t size = getU32(bytes.data() + pos);
+        std::uint32_t sum = getU32(bytes.data() + pos + 4);
+        unsigned char kind = (unsigned char)bytes[pos + 8];
+        if (size > bytes.size() - pos - RECORD_HEADER_SIZE)
+            break;  // torn append
+        std::string_view payload(bytes.data() + pos + RECORD_HEADER_SIZE, size);
+        if (checksum(kind, payload) != sum)
+            break;
+
+        if (kind == (unsigned char)Kind::Snapshot) {
+            if (!binaryToSaveData(state, std::string(payload)))
+                break;
+            haveSnapshot = true;
+        }
+        else if (kind == (unsigned char)Kind::Delta && haveSnapshot) {
+            SerializableSaveDelta delta;
+            auto ec = glz::read<glz::opts{.format = glz::BEVE, .error_on_unknown_keys = false}>(
+                delta, payload);
+            if (ec)
+                break;
+            applySaveDelta(state, delta);
+        }
+        else {
+            break;
+        }
+        pos += RECORD_HEADER_SIZE + size;
+    }
+
+    if (haveSnapshot)
+        out = std::move(state);
+    return haveSnapshot;
+}
+
+}  // namespace cereka
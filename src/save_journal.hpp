@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cereka {
+
+struct SerializableSaveData;
+struct SerializableSaveDelta;
+
+// Append-only autosave journal.
+//
+// Record is called at every interaction point with the current state. On
+// the caller's thread it only diffs against the previous record and queues
+// the delta; encoding, appending and fsync happen on the journal thread,
+// which gives every record arriving within BATCH_WINDOW of the first a
+// single fsync. Every COMPACT_AFTER records, and on Compact, the file is
+// rewritten atomically as one full snapshot.
+//
+// File layout: "CRJL" + u32 LE version, then records of
+//   u32 LE payload size, u32 LE FNV-1a of kind + payload, u8 kind, payload
+// where kind 0 is a full save (saveDataToBinary) and kind 1 a BEVE
+// SerializableSaveDelta. Replay stops at the first torn or corrupt record,
+// so a crash mid-append loses at most the batch that was being written.
+class SaveJournal {
+   public:
+    static constexpr int COMPACT_AFTER = 256;
+    static constexpr std::chrono::milliseconds BATCH_WINDOW{100};
+
+    explicit SaveJournal(std::string path = "saves/autosave.journal");
+    SaveJournal(const SaveJournal &) = delete;
+    SaveJournal &operator=(const SaveJournal &) = delete;
+    ~SaveJournal();
+
+    void Start();
+    // Finishes queued records first.
+    void Stop();
+
+    // Journal state as of an interaction point. Writes inline when the
+    // thread is not running.
+    void Record(SerializableSaveData state);
+    // Replace the journal with a snapshot of the last recorded state.
+    void Compact();
+    // Delete the journal (the playthrough ended); the next Record starts a
+    // new one.
+    void Discard();
+    // Block until every queued record is on disk.
+    void Flush();
+
+    const std::string &Path() const { return path; }
+
+    // Delta payload encoder, run on the journal thread; an empty result is a
+    // failed record. BEVE by default. Replaceable so tests can make it fail.
+    using DeltaEncoder = std::function<std::string(const SerializableSaveDelta &)>;
+    void SetDeltaEncoder(DeltaEncoder encoder);
+
+    // State as of the last intact record. False if there is no journal or
+    // it does not start with an intact snapshot.
+    static bool Replay(const std::string &path,
+                       SerializableSaveData &out);
+
+   private:
+    enum class Kind : unsigned char { Snapshot = 0, Delta = 1, Discard = 2 };
+    struct Job {
+        Kind kind;
+        std::function<std::string()> encode;  // payload, run on the journal thread
+    };
+
+    void queueSnapshot();
+    void push(Job job);
+    void workerLoop();
+    void writeBatch(std::deque<Job> &jobs);
+    void closeFile();
+
+    std::string path;
+
+    // Caller's thread only
+    std::unique_ptr<SerializableSaveData> last;  // state of the newest queued record
+    int sinceSnapshot = 0;
+    DeltaEncoder encodeDelta;
+
+    std::mutex mutex;
+    std::condition_variable workCv;  // worker: record queued, flush or stop
+    std::condition_variable idleCv;  // Flush: queue drained
+    std::deque<Job> queue;
+    bool busy = false;  // a batch is being written
+    bool flushing = false;
+    bool stopping = false;
+    std::thread worker;
+
+    // A snapshot or delta failed to reach the file; the chain on disk is
+    // broken until the next snapshot, so Record writes one.
+    std::atomic<bool> broken{false};
+    std::FILE *file = nullptr;  // append handle, journal thread only
+};
+
+}  // namespace cereka
@@ -0,0 +1,138 @@
+#include "save_writer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cereka {
+
+SaveWriter::~SaveWriter()
+{
+    Stop();
+}
+
+void SaveWriter::Start()
+{
+    Stop();
+    stopping = false;
+    worker = std::thread([this] { workerLoop(); });
+}
+
+void SaveWriter::Stop()
+{
+    if (!worker.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCv.notify_all();
+    worker.join();
+}
+
+void SaveWriter::Write(const std::string &path,
+                       std::string bytes)
+{
+    WriteWith(path, [bytes = std::move(bytes)] { return bytes; });
+}
+
+void SaveWriter::WriteWith(const std::string &path,
+                           std::function<std::string()> produce)
+{
+    if (!worker.joinable()) {
+        std::string bytes = produce();
+        if (!bytes.empty())
+            WriteAtomically(path, bytes);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(queue.begin(), queue.end(), [&](const Job &j) {
+            return j.path == path;
+        });
+        if (it != queue.end())
+            it->produce = std::move(produce);
+        else
+            queue.push_back({path, std::move(produce)});
+    }
+    workCv.notify_one();
+}
+
+bool SaveWriter::Pending(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return writing == path || std::any_of(queue.begin(), queue.end(), [&](const Job &j) {
+               return j.path == path;
+           });
+}
+
+void SaveWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idleCv.wait(lock, [this] { return queue.empty() && writing.empty(); });
+}
+
+void SaveWriter::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workCv.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            // Stopping with nothing left to write.
+            return;
+        }
+        Job job = std::move(queue.front());
+        queue.pop_front();
+        writing = job.path;
+        lock.unlock();
+
+        std::string bytes = job.produce();
+        if (!bytes.empty() && !WriteAtomically(job.path, bytes))
+            std::cerr << "[CEREKA] Failed to write save: " << job.path << "\n";
+
+        lock.lock();
+        writing.clear();
+        if (queue.empty())
+            idleCv.notify_all();
+    }
+}
+
+bool SaveWriter::WriteAtomically(const std::string &path,
+                                 const std::string &bytes)
+{
+    std::error_code ec;
+    fs::path target(path);
+    if (target.has_parent_path())
+        fs::create_directories(target.parent_path(), ec);
+
+    std::string tmp = path + ".tmp";
+    std::FILE *f = std::fopen(tmp.c_str(), "wb");
+    if (!f)
+        return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size() && std::fflush(f) == 0;
+    // The data must be on disk before the rename makes it the slot's save.
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(f)) == 0;
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = std::fclose(f) == 0 && ok;
+    if (ok) {
+        fs::rename(tmp, target, ec);
+        ok = !ec;
+    }
+    if (!ok)
+        fs::remove(tmp, ec);
+    return ok;
+}
+
+}  // namespace cereka
@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cereka {
+
+// Writes save files on a background thread so saving never blocks a frame.
+//
+// Each file is written to "<path>.tmp", flushed to disk and renamed over
+// path, so a slot holds either its previous save or the new one even if the
+// process dies mid-write.
+class SaveWriter {
+   public:
+    SaveWriter() = default;
+    SaveWriter(const SaveWriter &) = delete;
+    SaveWriter &operator=(const SaveWriter &) = delete;
+    ~SaveWriter();
+
+    void Start();
+    // Finishes queued writes first.
+    void Stop();
+
+    // Queue bytes for path. A queued write to the same path that has not
+    // started yet is replaced. Writes inline when the thread is not running.
+    void Write(const std::string &path,
+               std::string bytes);
+    // Same, but the bytes are produced on the writer thread (for encoding
+    // that should not cost the caller a frame). An empty result writes nothing.
+    void WriteWith(const std::string &path,
+                   std::function<std::string()> produce);
+
+    // True while a write to path is queued or in progress.
+    bool Pending(const std::string &path);
+
+    // Block until every queued write has landed (before reading a slot back).
+    void Flush();
+
+    // Write-temp, flush, rename. False (and path untouched) on any failure.
+    static bool WriteAtomically(const std::string &path,
+                                const std::string &bytes);
+
+   private:
+    struct Job {
+        std::string path;
+        std::function<std::string()> produce;
+    };
+
+    void workerLoop();
+
+    std::mutex mutex;
+    std::condition_variable workCv;  // worker: job queued or stop
+    std::condition_variable idleCv;  // Flush: queue drained
+    std::deque<Job> queue;
+    std::string writing;  // path being written, empty when idle
+    bool stopping = false;
+    std::thread worker;
+};
+
+}  // namespace cereka
@@ -1,19 +1,55 @@
 #include "scene_manager.hpp"
 
-#include <SDL3_image/SDL_image.h>
+#include <algorithm>
 #include <iostream>
 
 namespace cereka {
 
-void SceneManager::Init(SDL_Renderer *r)
+void SceneManager::Init(SDL_Renderer *r,
+                        TextureCache *cache)
 {
     renderer = r;
+    textures = cache;
+    if (!SDL_GetRenderOutputSize(renderer, &targetW, &targetH))
+        targetW = targetH = 0;
+}
+
+void SceneManager::SetTargetSize(int pixelW,
+                                 int pixelH)
+{
+    if (pixelW == targetW && pixelH == targetH)
+        return;
+    targetW = pixelW;
+    targetH = pixelH;
+
+    // Re-decode what is on screen at the new resolution.
+    if (!bgPath.empty()) {
+        if (SDL_Texture *tex = loadBg(bgPath)) {
+            textures->Release(background);
+            background = tex;
+        }
+    }
+    for (auto &[id, entry] : characters) {
+        auto pit = charPaths.find(id);
+        if (pit == charPaths.end())
+            continue;
+        if (SDL_Texture *tex = loadCharacter(pit->second)) {
+            textures->Release(entry.tex);
+            entry.tex = tex;
+        }
+    }
 }
 
 void SceneManager::Shutdown()
 {
     Clear();
+    if (snapshot) {
+        SDL_DestroyTexture(snapshot);
+        snapshot = nullptr;
+    }
+    snapshotW = snapshotH = 0;
     renderer = nullptr;
+    textures = nullptr;
 }
 
 float SceneManager::posToXNorm(const std::string &pos)
@@ -25,37 +61,57 @@ float SceneManager::posToXNorm(const std::string &pos)
     return 0.5f;
 }
 
+AssetPrefetcher::Request SceneManager::BackgroundRequest(const std::string &filename) const
+{
+    // Backgrounds are stretched to the full output, so each axis fits independently.
+    return {AssetPrefetcher::Request::Kind::Image, "assets/bg/" + filename, targetW, targetH};
+}
+
+AssetPrefetcher::Request SceneManager::CharacterRequest(const std::string &filename) const
+{
+    int maxH = (int)(targetH * CHARACTER_HEIGHT);
+    return {AssetPrefetcher::Request::Kind::Image, "assets/characters/" + filename, 0, maxH};
+}
+
 SDL_Texture *SceneManager::loadBg(const std::string &filename)
 {
-    SDL_Texture *tex = IMG_LoadTexture(renderer, ("assets/bg/" + filename).c_str());
+    SDL_Texture *tex = textures->Acquire(BackgroundRequest(filename));
     if (!tex)
         std::cerr << "[CEREKA] Failed to load bg: " << filename << " — " << SDL_GetError() << '\n';
     return tex;
 }
 
+SDL_Texture *SceneManager::loadCharacter(const std::string &filename)
+{
+    AssetPrefetcher::Request req = CharacterRequest(filename);
+    SDL_Texture *tex = textures->Acquire(req);
+    if (!tex) {
+        std::cerr << "[CEREKA] Failed to load character: " << req.path << " — " << SDL_GetError()
+                  << "\n";
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
 void SceneManager::ShowBackground(const std::string &filename)
 {
+    // Acquire before releasing so re-showing the current bg keeps it resident.
+    SDL_Texture *tex = loadBg(filename);
+    textures->Release(background);
+    background = tex;
     bgPath = filename;
-    if (background)
-        SDL_DestroyTexture(background);
-    background = loadBg(filename);
 }
 
 void SceneManager::ShowCharacter(const std::string &id,
                                  const std::string &filename,
                                  const std::string &pos)
 {
+    SDL_Texture *tex = loadCharacter(filename);
     HideCharacter(id);
-    charPaths[id] = filename;
-    std::string path = "assets/characters/" + filename;
-    SDL_Texture *tex = IMG_LoadTexture(renderer, path.c_str());
-    if (!tex) {
-        std::cerr << "[CEREKA] Failed to load character: " << path << " — " << SDL_GetError()
-                  << "\n";
-        charPaths.erase(id);
+    if (!tex)
         return;
-    }
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    charPaths[id] = filename;
     characters[id] = {tex, posToXNorm(pos)};
 }
 
@@ -64,7 +120,7 @@ void SceneManager::HideCharacter(const std::string &id)
     charPaths.erase(id);
     auto it = characters.find(id);
     if (it != characters.end()) {
-        SDL_DestroyTexture(it->second.tex);
+        textures->Release(it->second.tex);
         characters.erase(it);
     }
 }
@@ -75,9 +131,10 @@ void SceneManager::StartFade(const std::string &filename,
     fadePhaseDuration = totalDuration * 0.5f;
     fadeTimer = 0.0f;
     fadePhase = FadePhase::Out;
-    if (pendingBg)
-        SDL_DestroyTexture(pendingBg);
-    pendingBg = loadBg(filename);
+    SDL_Texture *tex = loadBg(filename);
+    textures->Release(pendingBg);
+    pendingBg = tex;
+    pendingBgPath = filename;
 }
 
 bool SceneManager::TickFade(float dt)
@@ -87,9 +144,9 @@ bool SceneManager::TickFade(float dt)
 
     fadeTimer += dt;
     if (fadePhase == FadePhase::Out && fadeTimer >= fadePhaseDuration) {
-        if (background)
-            SDL_DestroyTexture(background);
+        textures->Release(background);
         background = pendingBg;
+        bgPath = pendingBgPath;
         pendingBg = nullptr;
         fadePhase = FadePhase::In;
         fadeTimer = 0.0f;
@@ -103,23 +160,117 @@ bool SceneManager::TickFade(float dt)
     return false;
 }
 
-void SceneManager::Clear()
+SDL_Texture *SceneManager::SnapshotTarget(int w,
+                                          int h)
 {
-    if (background) {
-        SDL_DestroyTexture(background);
-        background = nullptr;
+    if (snapshot && snapshotW == w && snapshotH == h)
+        return snapshot;
+
+    if (snapshot)
+        SDL_DestroyTexture(snapshot);
+    snapshot =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!snapshot) {
+        std::cerr << "[CEREKA] Failed to create snapshot target: " << SDL_GetError() << '\n';
+        snapshotW = snapshotH = 0;
+        return nullptr;
     }
-    if (pendingBg) {
-        SDL_DestroyTexture(pendingBg);
-        pendingBg = nullptr;
+    SDL_SetTextureBlendMode(snapshot, SDL_BLENDMODE_BLEND);
+    snapshotW = w;
+    snapshotH = h;
+    return snapshot;
+}
+
+void SceneManager::StartDissolve(const std::string &filename,
+                                 float duration)
+{
+    ShowBackground(filename);
+    dissolveDuration = duration;
+    dissolveTimer = 0.0f;
+    dissolving = snapshot != nullptr && duration > 0.0f;
+}
+
+bool SceneManager::TickDissolve(float dt)
+{
+    if (!dissolving)
+        return false;
+
+    dissolveTimer += dt;
+    if (dissolveTimer >= dissolveDuration) {
+        dissolving = false;
+        dissolveTimer = 0.0f;
+        return true;
     }
+    return false;
+}
+
+float SceneManager::DissolveAlpha() const
+{
+    if (!dissolving)
+        return 0.0f;
+    float t = std::min(dissolveTimer / dissolveDuration, 1.0f);
+    return 1.0f - t;
+}
+
+void SceneManager::Clear()
+{
+    textures->Release(background);
+    background = nullptr;
+    textures->Release(pendingBg);
+    pendingBg = nullptr;
     bgPath.clear();
+    pendingBgPath.clear();
     for (auto &[id, entry] : characters)
-        SDL_DestroyTexture(entry.tex);
+        textures->Release(entry.tex);
     characters.clear();
     charPaths.clear();
     fadePhase = FadePhase::None;
     fadeTimer = 0.0f;
+    dissolving = false;
+    dissolveTimer = 0.0f;
+}
+
+void SceneManager::Restore(const std::string &bg,
+                           const std::vector<CharacterPlacement> &chars)
+{
+    if (fadePhase == FadePhase::Out && pendingBg) {
+        textures->Release(background);
+        background = pendingBg;
+        bgPath = pendingBgPath;
+        pendingBg = nullptr;
+    }
+    fadePhase = FadePhase::None;
+    fadeTimer = 0.0f;
+    dissolving = false;
+    dissolveTimer = 0.0f;
+
+    if (bg.empty()) {
+        textures->Release(background);
+        background = nullptr;
+        bgPath.clear();
+    }
+    else if (bg != bgPath || !background) {
+        ShowBackground(bg);
+    }
+
+    std::vector<std::string> gone;
+    for (const auto &[id, file] : charPaths) {
+        if (std::none_of(chars.begin(), chars.end(), [&](const CharacterPlacement &c) {
+                return c.id == id;
+            }))
+            gone.push_back(id);
+    }
+    for (const std::string &id : gone)
+        HideCharacter(id);
+
+    for (const CharacterPlacement &c : chars) {
+        auto path = charPaths.find(c.id);
+        auto entry = characters.find(c.id);
+        if (path != charPaths.end() && path->second == c.file && entry != characters.end())
+            entry->second.xNorm = posToXNorm(c.pos);
+        else
+            ShowCharacter(c.id, c.file, c.pos);
+    }
 }
 
 }  // namespace cereka
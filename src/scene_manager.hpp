@@ -1,8 +1,11 @@
 #pragma once
 
+#include "texture_cache.hpp"
+
 #include <SDL3/SDL.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cereka {
 
@@ -10,14 +13,34 @@ class SceneManager {
    public:
     enum class FadePhase { None, Out, In };
 
+    // Characters are drawn at this fraction of the screen height.
+    static constexpr float CHARACTER_HEIGHT = 0.8f;
+
     struct CharacterEntry {
         SDL_Texture *tex;
         float xNorm;  // 0.0–1.0 horizontal centre
     };
 
-    void Init(SDL_Renderer *r);
+    struct CharacterPlacement {
+        std::string id;
+        std::string file;
+        std::string pos;  // left|center|right
+    };
+
+    // Scene textures are borrowed from the shared cache and released, not destroyed.
+    void Init(SDL_Renderer *r,
+              TextureCache *cache);
     void Shutdown();
 
+    // Pixel size of the render output. Images are downscaled at load time to
+    // what they will occupy on screen; a change reloads the visible scene.
+    void SetTargetSize(int pixelW,
+                       int pixelH);
+
+    // Cache / prefetch requests matching exactly what loadBg / loadCharacter decode.
+    AssetPrefetcher::Request BackgroundRequest(const std::string &filename) const;
+    AssetPrefetcher::Request CharacterRequest(const std::string &filename) const;
+
     void ShowBackground(const std::string &filename);
     void ShowCharacter(const std::string &id,
                        const std::string &filename,
@@ -30,9 +53,27 @@ class SceneManager {
     // Advance fade by dt. Returns true when the fade finishes on this tick.
     bool TickFade(float dt);
 
-    // Tear down all textures (used by Reset and LoadGame).
+    // Render target the outgoing scene is captured into before a dissolve.
+    // (Re)created when the requested size changes; owned by SceneManager.
+    SDL_Texture *SnapshotTarget(int w,
+                                int h);
+    // Begin a dissolve: swap to the new bg immediately and blend the captured
+    // snapshot out over duration seconds. Call after rendering into SnapshotTarget.
+    void StartDissolve(const std::string &filename,
+                       float duration);
+    // Advance dissolve by dt. Returns true when the dissolve finishes on this tick.
+    bool TickDissolve(float dt);
+
+    // Release all scene textures (used by Reset).
     void Clear();
 
+    // Make the scene show exactly bg and chars (used by LoadGame). Only what
+    // differs is loaded; a background or character already showing the same
+    // file keeps its texture, and a moved character is only repositioned.
+    // A fade or dissolve in progress is finished first.
+    void Restore(const std::string &bg,
+                 const std::vector<CharacterPlacement> &chars);
+
     SDL_Texture *Background() const { return background; }
     const std::string &BgPath() const { return bgPath; }
     const std::unordered_map<std::string, CharacterEntry> &Characters() const { return characters; }
@@ -42,20 +83,37 @@ class SceneManager {
     float FadeTimer() const { return fadeTimer; }
     float FadePhaseDuration() const { return fadePhaseDuration; }
 
+    bool Dissolving() const { return dissolving; }
+    SDL_Texture *Snapshot() const { return snapshot; }
+    // Opacity of the outgoing snapshot: 1.0 at start, 0.0 when finished.
+    float DissolveAlpha() const;
+
     static float posToXNorm(const std::string &pos);
 
    private:
     SDL_Texture *loadBg(const std::string &filename);
+    SDL_Texture *loadCharacter(const std::string &filename);
 
     SDL_Renderer *renderer = nullptr;
+    TextureCache *textures = nullptr;
+    int targetW = 0;
+    int targetH = 0;
     SDL_Texture *background = nullptr;
     std::string bgPath;
     std::unordered_map<std::string, CharacterEntry> characters;
     std::unordered_map<std::string, std::string> charPaths;
     SDL_Texture *pendingBg = nullptr;
+    std::string pendingBgPath;
     FadePhase fadePhase = FadePhase::None;
     float fadePhaseDuration = 0.25f;
     float fadeTimer = 0.0f;
+
+    SDL_Texture *snapshot = nullptr;
+    int snapshotW = 0;
+    int snapshotH = 0;
+    bool dissolving = false;
+    float dissolveDuration = 0.5f;
+    float dissolveTimer = 0.0f;
 };
 
 }  // namespace cereka
@@ -9,7 +9,8 @@
 // Script loading
 // ---------------------------------------------------------------------------
 
-void Impl::LoadCompiledScript(const std::vector<scenario::Instruction> &compiled)
+void Impl::LoadCompiledScript(const std::vector<scenario::Instruction> &compiled,
+                              std::optional<scenario::AssetManifest> built)
 {
     scriptInterpreter.program = compiled;
     scriptInterpreter.pc = 0;
@@ -19,11 +20,53 @@ void Impl::LoadCompiledScript(const std::vector<scenario::Instruction> &compiled
     scriptInterpreter.callStack.clear();
     scriptInterpreter.skipMode = false;
     scriptInterpreter.skipDepth = 0;
+    uiApplied.clear();
+    playtime = 0.0;
+    IndexProgram(std::move(built));
+}
 
+// Everything derived from the program: labels, asset manifest, read-line
+// bits, ui patches and the look-ahead window.
+void Impl::IndexProgram(std::optional<scenario::AssetManifest> built)
+{
     scriptInterpreter.labelMap.clear();
     for (size_t i = 0; i < scriptInterpreter.program.size(); ++i)
         if (scriptInterpreter.program[i].op == scenario::Op::LABEL)
             scriptInterpreter.labelMap[scriptInterpreter.program[i].a] = i;
+    // A compile hands over the manifest it built with the program.
+    if (built)
+        manifest = std::move(*built);
+    else
+        manifest = scenario::BuildAssetManifest(scriptInterpreter.program);
+    globalData.BindProgram(scriptInterpreter.program);
+    CompileUiPatches();
+
+    prefetchPc = SIZE_MAX;
+    PrefetchAhead();
+}
+
+std::vector<cereka::scenario::Instruction> Impl::TakeCompiledScript()
+{
+    if (!compiledScript.valid())
+        return {};
+    // Logged so the log shows how much of the compile init failed to hide.
+    startup_profile::Span span("wait for script");
+    return compiledScript.get().program;
+}
+
+bool Impl::LoadEntryScript()
+{
+    if (!compiledScript.valid())
+        return false;
+    CompiledProgram compiled;
+    {
+        startup_profile::Span span("wait for script");
+        compiled = compiledScript.get();
+    }
+    if (compiled.program.empty())
+        return false;
+    LoadCompiledScript(compiled.program, std::move(compiled.manifest));
+    return true;
 }
 
 void Impl::LoadScript(const std::string &filename)
@@ -38,6 +81,101 @@ void Impl::LoadScript(const std::string &filename)
     scriptInterpreter.scriptFinished = false;
 }
 
+// ---------------------------------------------------------------------------
+// Hot reload — dev mode: recompile edited scripts and swap the program in
+// ---------------------------------------------------------------------------
+
+bool Impl::EnableHotReload()
+{
+    if (entryScript.empty() || !scriptWatcher.Watch(compileCache.sources))
+        return false;
+    std::cerr << "[CEREKA] Hot reload: watching " << compileCache.sources.size()
+              << " script file(s)\n";
+    return true;
+}
+
+void Impl::PollHotReload()
+{
+    if (!scriptWatcher.Watching())
+        return;
+
+    if (scriptWatcher.Changed() && !reloadQueued) {
+        reloadQueued = true;
+        reloadStarted = std::chrono::steady_clock::now();
+    }
+    if (reloadQueued && !reloadedScript.valid()) {
+        reloadQueued = false;
+        reloadedScript = std::async(std::launch::async, [this] {
+            CompiledProgram out;
+            out.program = scenario::CompileVNScript(entryScript, &compileCache, &out.manifest);
+            return out;
+        });
+    }
+
+    if (!reloadedScript.valid() ||
+        reloadedScript.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+    // Only between VM steps: not mid-fade or under the save / load overlay.
+    CerekaState at = states.currentType();
+    if (at != CerekaState::Running && at != CerekaState::WaitingForInput &&
+        at != CerekaState::InMenu)
+        return;
+
+    CompiledProgram reloaded = reloadedScript.get();
+    // Includes may have been added or removed.
+    scriptWatcher.Watch(compileCache.sources);
+    if (reloaded.program.empty()) {
+        std::cerr << "[CEREKA] Hot reload: compile failed, keeping the running script\n";
+        return;
+    }
+    HotSwapProgram(std::move(reloaded.program), std::move(reloaded.manifest));
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - reloadStarted);
+    std::cerr << "[CEREKA] Hot reload: swapped in " << ms.count() << " ms\n";
+}
+
+// Replace the program, keeping variables, scene, audio and dialogue state.
+// The pc and call stack are carried over through MapProgramCounter.
+void Impl::HotSwapProgram(std::vector<scenario::Instruction> program,
+                          scenario::AssetManifest built)
+{
+    auto &si = scriptInterpreter;
+
+    // Waiting states have already stepped past the line or menu they show;
+    // map that instruction instead and run it again so its edits appear.
+    bool rerun = states.baseType() == CerekaState::WaitingForInput ||
+                 states.baseType() == CerekaState::InMenu;
+    size_t at = rerun && si.pc > 0 ? si.pc - 1 : si.pc;
+
+    std::vector<scenario::Instruction> old = std::move(si.program);
+    si.program = std::move(program);
+    std::vector<size_t> applied = std::move(uiApplied);
+    uiApplied.clear();
+    IndexProgram(std::move(built));
+
+    at = MapProgramCounter(old, at, si.program, si.labelMap);
+    for (size_t &ret : si.callStack)
+        ret = MapProgramCounter(old, ret, si.program, si.labelMap);
+    si.pc = at;
+    si.scriptFinished = false;
+
+    if (rerun)
+        states.changeState(CerekaState::Running);  // closes a menu
+
+    // Re-run the ui lines that had run, in the same order, as the new
+    // program words them. A line that no longer maps to a setting of the
+    // same property was deleted; the value it set stays.
+    for (size_t pc : applied) {
+        size_t to = MapProgramCounter(old, pc, si.program, si.labelMap);
+        if (to < si.program.size() && si.program[to].op == scenario::Op::UI_SET &&
+            si.program[to].a == old[pc].a)
+            ApplyUiPatch(to);
+    }
+
+    prefetchPc = SIZE_MAX;
+    PrefetchAhead();
+}
+
 void Impl::Reset()
 {
     dialogue.Clear();
@@ -50,82 +188,99 @@ void Impl::Reset()
 
 void Impl::Update(float dt)
 {
+    // Measured rather than summed from dt: callers may step at a fixed rate
+    // that does not match how fast frames really arrive.
+    auto now = std::chrono::steady_clock::now();
+    if (playtimeTick != std::chrono::steady_clock::time_point{})
+        playtime += std::chrono::duration<double>(now - playtimeTick).count();
+    playtimeTick = now;
     dialogue.Tick(dt);
 
-    if (state == CerekaState::Fading && scene.TickFade(dt))
-        state = CerekaState::Running;
+    states.update(dt);
+
+    // Dissolves do not block the VM: instructions after the bg swap build the
+    // incoming scene while the snapshot of the outgoing one blends out.
+    scene.TickDissolve(dt);
+
+    audio.Update();
+    PollHotReload();
+    PrefetchAhead();
 }
 
 // ---------------------------------------------------------------------------
-// Event handling
+// Look-ahead — decode assets the script is about to need on worker threads
 // ---------------------------------------------------------------------------
 
-void Impl::HandleEvent(const CerekaEvent &e)
+void Impl::PrefetchAhead()
 {
-    if (e.type == CerekaEvent::Quit) {
-        state = CerekaState::Quit;
+    using scenario::Op;
+
+    if (scriptInterpreter.pc == prefetchPc)
         return;
-    }
+    prefetchPc = scriptInterpreter.pc;
 
-    // Save/Load overlay — intercept all input while overlay is open
-    if (state == CerekaState::SaveMenuState || state == CerekaState::LoadMenuState) {
-        bool isSaving = (state == CerekaState::SaveMenuState);
-        if (e.type == CerekaEvent::KeyDown && e.key == SDLK_ESCAPE) {
-            state = stateBeforeSaveMenu;
-            return;
-        }
-        if (e.type == CerekaEvent::MouseDown) {
-            int slot = HitTestSaveSlot((int)e.mouseX, (int)e.mouseY);
-            if (slot >= 1 && slot <= 10) {
-                if (isSaving) {
-                    SaveGame(slot);
-                    state = stateBeforeSaveMenu;
-                }
-                else {
-                    LoadGame(slot);  // restores state from file
-                }
-            }
+    const auto &program = scriptInterpreter.program;
+    std::vector<AssetPrefetcher::Request> wanted;
+    for (size_t i : AssetPrefetcher::ScanAhead(program, scriptInterpreter.labelMap, prefetchPc)) {
+        const auto &ins = program[i];
+        switch (ins.op) {
+            case Op::BG:
+            case Op::FADE:
+            case Op::DISSOLVE:
+                if (auto req = scene.BackgroundRequest(ins.a); !textures.Contains(req))
+                    wanted.push_back(std::move(req));
+                break;
+            case Op::CHAR:
+                if (auto req = scene.CharacterRequest(ins.b); !textures.Contains(req))
+                    wanted.push_back(std::move(req));
+                break;
+            case Op::PLAY_BGM:
+                if (ins.a != audio.BgmPath())
+                    wanted.push_back(audio.MusicRequest(ins.a));
+                break;
+            case Op::PLAY_SFX:
+            case Op::PRELOAD_SFX:
+                if (!audio.HasCachedSfx(ins.a))
+                    wanted.push_back(AudioManager::SoundRequest(ins.a));
+                break;
+            default:
+                break;
         }
-        return;
     }
+    prefetcher.SetWanted(wanted);
+}
 
-    // Escape during normal play opens save menu
-    if (e.type == CerekaEvent::KeyDown && e.key == SDLK_ESCAPE) {
-        if (state == CerekaState::WaitingForInput || state == CerekaState::Running) {
-            stateBeforeSaveMenu = state;
-            state = CerekaState::SaveMenuState;
-            return;
-        }
+// ---------------------------------------------------------------------------
+// Event handling
+// ---------------------------------------------------------------------------
+
+// Input that changes the engine state or the save page shows its effect in
+// the next presented frame; Present records how long that took.
+void Impl::HandleEvent(const CerekaEvent &e)
+{
+    CerekaState stateBefore = states.currentType();
+    int pageBefore = savePage;
+    if (e.type == CerekaEvent::Quit)
+        states.changeState(CerekaState::Quit);
+    else
+        states.handleEvent(e);
+    if (e.timestamp && (states.currentType() != stateBefore || savePage != pageBefore)) {
+        if (!inputAwaitingPresentNs || e.timestamp < inputAwaitingPresentNs)
+            inputAwaitingPresentNs = e.timestamp;
     }
+}
 
-    if (state == CerekaState::WaitingForInput &&
-        (e.type == CerekaEvent::MouseDown ||
-         (e.type == CerekaEvent::KeyDown &&
-          std::find(uiCfg.advanceKeys.begin(), uiCfg.advanceKeys.end(), (SDL_Keycode)e.key) !=
-              uiCfg.advanceKeys.end())))
-    {
-        state = CerekaState::Running;
+// Leaving InMenu closes the menu (MenuState::onExit).
+void Impl::ChooseMenuOption(size_t idx)
+{
+    if (menu.IsExit(idx)) {
+        states.changeState(CerekaState::Finished);
         return;
     }
 
-    if (state == CerekaState::InMenu && e.type == CerekaEvent::MouseDown) {
-        int idx = menu.HitTest(
-            e.mouseX, e.mouseY, screenWidth, screenHeight, uiCfg.button.w, uiCfg.button.h);
-        if (idx < 0)
-            return;
-
-        if (menu.IsExit(idx)) {
-            ExitMenu();
-            state = CerekaState::Finished;
-            return;
-        }
-
-        const std::string &target = menu.Target(idx);
-        scriptInterpreter.pc =
-            target.empty() ? menu.EndPC() : scriptInterpreter.labelMap[target];
-        ExitMenu();
-        state = CerekaState::Running;
-    }
+    const std::string &target = menu.Target(idx);
+    scriptInterpreter.pc = target.empty() ? menu.EndPC() : scriptInterpreter.labelMap[target];
+    states.changeState(CerekaState::Running);
 }
 
 // ---------------------------------------------------------------------------
@@ -134,7 +289,7 @@ void Impl::HandleEvent(const CerekaEvent &e)
 
 void Impl::TickScript()
 {
-    if (state != CerekaState::Running)
+    if (states.currentType() != CerekaState::Running)
         return;
 
     auto &si = scriptInterpreter;  // local alias keeps dispatch readable
@@ -179,11 +334,26 @@ void Impl::TickScript()
                     }
                 }
                 scene.StartFade(ins.a, totalDur);
-                state = CerekaState::Fading;
+                states.changeState(CerekaState::Fading);
                 si.pc++;
                 return;
             }
 
+            case scenario::Op::DISSOLVE: {
+                float duration = 0.5f;
+                if (!ins.b.empty()) {
+                    try {
+                        duration = std::stof(ins.b);
+                    }
+                    catch (...) {
+                    }
+                }
+                CaptureScene();
+                scene.StartDissolve(ins.a, duration);
+                si.pc++;
+                continue;
+            }
+
             case scenario::Op::CHAR:
                 scene.ShowCharacter(ins.a, ins.b, ins.c);
                 si.pc++;
@@ -196,19 +366,24 @@ void Impl::TickScript()
 
             case scenario::Op::SAY:
                 Say(ins.a, ins.a, ins.b);
-                state = CerekaState::WaitingForInput;
+                globalData.MarkSeen(si.pc);
+                states.changeState(CerekaState::WaitingForInput);
+                Autosave(si.pc);
                 si.pc++;
                 return;
 
             case scenario::Op::NARRATE:
                 Narrate(ins.b);
-                state = CerekaState::WaitingForInput;
+                globalData.MarkSeen(si.pc);
+                states.changeState(CerekaState::WaitingForInput);
+                Autosave(si.pc);
                 si.pc++;
                 return;
 
             case scenario::Op::MENU:
                 EnterMenu();
-                state = CerekaState::InMenu;
+                states.changeState(CerekaState::InMenu);
+                Autosave(si.pc);
                 si.pc++;
                 return;
 
@@ -227,7 +402,7 @@ void Impl::TickScript()
                     si.callStack.pop_back();
                 }
                 else {
-                    state = CerekaState::Finished;
+                    states.changeState(CerekaState::Finished);
                 }
                 continue;
 
@@ -319,10 +494,19 @@ void Impl::TickScript()
                 si.pc++;
                 continue;
 
-            case scenario::Op::PLAY_BGM:
-                audio.PlayBGM(ins.a);
+            case scenario::Op::PLAY_BGM: {
+                float crossfade = 0.0f;
+                if (!ins.b.empty()) {
+                    try {
+                        crossfade = std::stof(ins.b);
+                    }
+                    catch (...) {
+                    }
+                }
+                audio.PlayBGM(ins.a, crossfade);
                 si.pc++;
                 continue;
+            }
 
             case scenario::Op::STOP_BGM:
                 audio.StopBGM();
@@ -334,42 +518,53 @@ void Impl::TickScript()
                 si.pc++;
                 continue;
 
+            case scenario::Op::PRELOAD_SFX:
+                audio.PreloadSFX(ins.a);
+                si.pc++;
+                continue;
+
             case scenario::Op::UI_SET:
-                ApplyUiSet(ins.a, ins.b);
+                ApplyUiPatch(si.pc);
                 si.pc++;
                 continue;
 
             case scenario::Op::SAVE_MENU:
-                stateBeforeSaveMenu = state;
-                state = CerekaState::SaveMenuState;
+                states.pushOverlay(CerekaState::SaveMenuState);
                 si.pc++;
                 return;
 
             case scenario::Op::LOAD_MENU:
-                stateBeforeSaveMenu = state;
-                state = CerekaState::LoadMenuState;
+                states.pushOverlay(CerekaState::LoadMenuState);
                 si.pc++;
                 return;
 
             case scenario::Op::SAVE: {
                 int slot = ins.a.empty() ? 0 : std::stoi(ins.a);
-                if (slot >= 1 && slot <= 10) {
-                    stateBeforeSaveMenu = state;
+                if (slot >= 1)
                     SaveGame(slot);
-                }
                 si.pc++;
                 continue;
             }
 
             case scenario::Op::LOAD: {
                 int slot = ins.a.empty() ? 0 : std::stoi(ins.a);
-                if (slot >= 1 && slot <= 10)
+                if (slot >= 1)
                     LoadGame(slot);  // restores pc and state from file
                 return;
             }
 
+            case scenario::Op::UNLOCK:
+                globalData.Unlock(ins.a);
+                si.pc++;
+                continue;
+
+            case scenario::Op::ENDING:
+                globalData.ReachEnding(ins.a);
+                si.pc++;
+                continue;
+
             case scenario::Op::END:
-                state = CerekaState::Finished;
+                states.changeState(CerekaState::Finished);
                 return;
 
             case scenario::Op::LABEL:
@@ -0,0 +1,68 @@
+#include "sfx_pool.hpp"
+
+namespace cereka::sfx_pool {
+
+int PickVoice(std::span<const VoiceState> voices,
+              const std::string *sound,
+              int maxPerSound)
+{
+    int idle = -1;
+    int oldest = -1;
+    int oldestSame = -1;
+    int same = 0;
+    for (int i = 0; i < (int)voices.size(); ++i) {
+        const VoiceState &v = voices[i];
+        if (!v.usable)
+            continue;
+        if (!v.sound || !v.playing) {
+            if (idle < 0)
+                idle = i;
+            continue;
+        }
+        if (v.sound == sound) {
+            ++same;
+            if (oldestSame < 0 || v.started < voices[oldestSame].started)
+                oldestSame = i;
+        }
+        if (oldest < 0 || v.started < voices[oldest].started)
+            oldest = i;
+    }
+    if (same >= maxPerSound)
+        return oldestSame;
+    return idle >= 0 ? idle : oldest;
+}
+
+void Lru::Touch(const std::string *sound,
+                std::size_t bytes)
+{
+    auto it = where.find(sound);
+    if (it != where.end()) {
+        order.splice(order.begin(), order, it->second);
+        return;
+    }
+    order.push_front({sound, bytes});
+    where[sound] = order.begin();
+    resident += bytes;
+}
+
+std::vector<const std::string *> Lru::TakeOverBudget(std::size_t budget)
+{
+    std::vector<const std::string *> out;
+    while (resident > budget && order.size() > 1) {
+        const Item &victim = order.back();
+        out.push_back(victim.sound);
+        resident -= victim.bytes;
+        where.erase(victim.sound);
+        order.pop_back();
+    }
+    return out;
+}
+
+void Lru::Clear()
+{
+    order.clear();
+    where.clear();
+    resident = 0;
+}
+
+}  // namespace cereka::sfx_pool
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cereka::sfx_pool {
+
+// Decisions behind AudioManager's sound effects (which voice a play takes,
+// which cached sounds are dropped), kept apart from the mixer so they can
+// be tested on their own. Sounds are identified by a pointer that stays
+// valid while the sound is cached; AudioManager uses its cache's map keys.
+
+struct VoiceState {
+    const std::string *sound = nullptr;  // null when idle
+    std::uint64_t started = 0;           // larger is newer
+    bool playing = false;
+    bool usable = true;  // false if the voice's track could not be created
+};
+
+// Index of the voice a new play of sound takes, or -1 if none is usable:
+// the sound's own oldest voice once it holds maxPerSound, else the first
+// idle voice, else the oldest one (stolen).
+int PickVoice(std::span<const VoiceState> voices,
+              const std::string *sound,
+              int maxPerSound);
+
+// Recency order and resident total of the cached sounds.
+class Lru {
+   public:
+    // Record a use. A new sound is added with its size; a known one moves
+    // to the front.
+    void Touch(const std::string *sound,
+               std::size_t bytes = 0);
+    // Least recently used sounds to drop so the total fits budget, removed
+    // from the order. The most recent one is never returned, so a sound
+    // bigger than the whole budget can still play.
+    std::vector<const std::string *> TakeOverBudget(std::size_t budget);
+    void Clear();
+
+    std::size_t Resident() const { return resident; }
+    std::size_t Size() const { return order.size(); }
+
+   private:
+    struct Item {
+        const std::string *sound;
+        std::size_t bytes;
+    };
+
+    std::list<Item> order;  // most recently used first
+    std::unordered_map<const std::string *, std::list<Item>::iterator> where;
+    std::size_t resident = 0;
+};
+
+}  // namespace cereka::sfx_pool
@@ -0,0 +1,44 @@
+#include "startup_profile.hpp"
+
+#include <iostream>
+#include <sstream>
+
+namespace cereka::startup_profile {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point launch = Clock::now();
+
+double msBetween(Clock::time_point a,
+                 Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+}  // namespace
+
+double SinceLaunchMs()
+{
+    return msBetween(launch, Clock::now());
+}
+
+Span::Span(std::string n)
+    : name(std::move(n)), start(Clock::now())
+{
+}
+
+Span::~Span()
+{
+    Clock::time_point end = Clock::now();
+    // One write per line so spans finishing on other threads do not interleave.
+    std::ostringstream line;
+    line.setf(std::ios::fixed);
+    line.precision(1);
+    line << "[CEREKA] startup " << name << ": " << msBetween(start, end) << " ms (done at "
+         << msBetween(launch, end) << " ms)\n";
+    std::cerr << line.str();
+}
+
+}  // namespace cereka::startup_profile
@@ -0,0 +1,29 @@
+#pragma once
+#include <chrono>
+#include <string>
+
+namespace cereka::startup_profile {
+
+/**
+ * Milliseconds since the engine library was loaded, which in practice is
+ * process launch.
+ */
+double SinceLaunchMs();
+
+/**
+ * Times one startup phase and logs "startup <name>: <ms> ms" when it goes
+ * out of scope. Spans may run on several threads at once.
+ */
+class Span {
+   public:
+    explicit Span(std::string name);
+    ~Span();
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+   private:
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace cereka::startup_profile
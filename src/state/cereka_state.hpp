@@ -1,229 +1,248 @@
 #pragma once
 // cereka_state.hpp — Cereka VN Engine State System
 //
-// Implements a hierarchical state machine pattern for managing game flow.
-// States encapsulate their own behavior (enter, exit, update, events).
+// Static-dispatch state machine that drives the engine loop: every frame's
+// update, every input event and every draw go through it.
 //
-// Enterprise patterns:
-// - RAII for resource management
-// - std::expected for error handling
-// - Pure virtual interfaces
-// - Self-documenting code
+// Each CerekaState value has exactly one state type. A state type has no
+// data; it supplies static hooks (onEnter, onExit, update, handleEvent,
+// draw) that receive the engine as the context. The machine builds one
+// table of those hooks at compile time, indexed by the CerekaState value,
+// so dispatch is a single indexed call with no virtual functions and no
+// heap-allocated state objects.
+//
+// Overlays (save / load menus, later backlog, preferences) sit on a
+// fixed-capacity stack above the base state. Events, updates and draw go to
+// the topmost overlay only: an overlay paints its own backdrop, normally a
+// capture of drawBelow taken when it opened, so a frame under any number of
+// overlays costs the same as one. Pushing and popping copy an enum value,
+// so transitions never allocate.
 //
 // State hierarchy:
-//   IVNState (interface)
-//     └── VNState<T> (CRTP base)
-//           └── Concrete states (DialogueState, MenuState, etc.)
+//   VNState<Context, Id, Overlay>  (no-op hooks + compile-time id)
+//     └── Concrete states (DialogueState, MenuState, ...) hide the hooks
+//         they need with their own static functions
+//
+// Adding a state or overlay: add the CerekaState value, declare its type in
+// cereka_states.hpp and list it in EngineStates. The tables check at
+// compile time that every value has exactly one type.
 //
 // Usage:
-//   CerekaStateMachine sm;
-//   sm.registerState<DialogueState>();
-//   sm.registerState<MenuState>();
-//   sm.setInitialState(CerekaState::Dialogue);
+//   using Machine = CerekaStateMachine<Engine, DialogueState, MenuState, ...>;
+//   Machine sm{engine};
+//   sm.changeState(CerekaState::InMenu);  // MenuState::onEnter(engine)
+//   sm.handleEvent(e);                    // MenuState::handleEvent(engine, e)
 
 #ifndef CEREKA_STATE_HPP
 #    define CEREKA_STATE_HPP
 
 #    include "Cereka/Cereka.hpp"
-#    include <expected>
-#    include <functional>
-#    include <memory>
-#    include <string>
-#    include <unordered_map>
-#    include <utility>
-#    include <vector>
+#    include <array>
+#    include <cstddef>
+#    include <iostream>
 
 namespace cereka {
 
 // ============================================================================
-// IVNStateContext — Interface for state → engine communication
+// VNState — Base for all VN game states
 // ============================================================================
 
 /**
- * @brief Interface for VN states to request actions from the engine.
+ * @brief Compile-time identity and default (no-op) hooks of a state.
  *
- * States should never directly manipulate engine state. They request
- * changes through this interface, enabling loose coupling and testability.
- */
-class IVNStateContext {
-   public:
-    virtual ~IVNStateContext() = default;
-
-    virtual void changeState(CerekaState newState) = 0;
-    virtual void pushOverlay(CerekaState overlayState) = 0;
-    virtual void popOverlay() = 0;
-    virtual CerekaState getSavedState() const = 0;
-    virtual void setSavedState(CerekaState state) = 0;
-};
-
-// ============================================================================
-// IVNState — Abstract base for all VN game states
-// ============================================================================
-
-/**
- * @brief Abstract base for all visual novel game states.
+ * Derived states declare static functions with the same names to replace
+ * the defaults:
+ *
+ *   struct MenuState : VNState<Engine, CerekaState::InMenu> {
+ *       static void handleEvent(Engine &engine, const CerekaEvent &e);
+ *   };
  *
- * Each state encapsulates:
- * - onEnter: Called when state becomes active
- * - onExit: Called when state becomes inactive
- * - update: Per-frame logic (dt = delta time in seconds)
- * - handleEvent: Input event processing
- * - draw: Per-frame rendering
+ * Overlay states pass Overlay = true; they are entered with pushOverlay and
+ * must paint what is beneath them (see CerekaStateMachine::drawBelow).
  */
-class IVNState {
-   public:
-    virtual ~IVNState() = default;
-
-    [[nodiscard]] virtual CerekaState type() const = 0;
-
-    virtual void onEnter(IVNStateContext &) {}
-    virtual void onExit(IVNStateContext &) {}
-    virtual void update(float dt,
-                        IVNStateContext &)
+template<typename Context,
+         CerekaState Id,
+         bool Overlay = false>
+struct VNState {
+    static constexpr CerekaState ID = Id;
+    static constexpr bool OVERLAY = Overlay;
+
+    static void onEnter(Context &) {}
+    static void onExit(Context &) {}
+    static void update(Context &,
+                       float /*dt*/)
     {
     }
-    virtual void draw(IVNStateContext &) const {}
-    virtual void handleEvent(const CerekaEvent &event,
-                             IVNStateContext &)
+    static void handleEvent(Context &,
+                            const CerekaEvent &)
     {
     }
+    static void draw(Context &) {}
 };
 
 // ============================================================================
-// VNState — CRTP template for simple states
-// ============================================================================
-
-/**
- * @brief CRTP base class for states with compile-time type dispatch.
- *
- * Usage:
- *   class DialogueState : public VNState<CerekaState::Dialogue> {
- *       void onEnter(IVNStateContext& ctx) override { ... }
- *   };
- */
-template<CerekaState T> class VNState : public IVNState {
-   public:
-    [[nodiscard]] CerekaState type() const override
-    {
-        return T;
-    }
-};
-
-// ============================================================================
-// CerekaStateMachine — Manages state transitions and overlays
+// CerekaStateMachine — Dispatches to the active state, manages overlays
 // ============================================================================
 
+template<typename Context,
+         typename... States>
 class CerekaStateMachine {
    public:
-    CerekaStateMachine() = default;
+    static constexpr std::size_t STATE_COUNT = (std::size_t)CerekaState::COUNT;
+    static constexpr std::size_t MAX_OVERLAYS = 4;
 
-    void setContext(IVNStateContext &ctx)
+    explicit CerekaStateMachine(Context &ctx)
+        : ctx_(ctx)
     {
-        ctx_ = &ctx;
+        static_assert(sizeof...(States) == STATE_COUNT,
+                      "each CerekaState needs exactly one state type");
+        static_assert(((index(States::ID) < STATE_COUNT) && ...),
+                      "state ids must be CerekaState values other than COUNT");
+        static_assert(everyStateListed(), "each CerekaState needs exactly one state type");
     }
 
-    template<typename StateT> void registerState()
+    CerekaStateMachine(const CerekaStateMachine &) = delete;
+    CerekaStateMachine &operator=(const CerekaStateMachine &) = delete;
+
+    [[nodiscard]] static constexpr bool isState(CerekaState type)
     {
-        static_assert(std::is_base_of_v<IVNState, StateT>, "StateT must derive from IVNState");
-        auto state = std::make_unique<StateT>();
-        CerekaState type = state->type();
-        states_[type] = std::move(state);
+        return (std::size_t)type < STATE_COUNT;
     }
 
-    void setInitialState(CerekaState type)
+    [[nodiscard]] static constexpr bool isOverlay(CerekaState type)
     {
-        auto it = states_.find(type);
-        if (it != states_.end()) {
-            currentType_ = type;
-            currentState_ = it->second.get();
-            currentState_->onEnter(*ctx_);
-        }
+        return isState(type) && table_[index(type)].overlay;
     }
 
+    /**
+     * @brief Replace the base state (the one under any overlays). Runs the
+     * old state's onExit and the new one's onEnter; no-op if unchanged.
+     */
     void changeState(CerekaState newType)
     {
-        if (!currentState_ || !ctx_)
+        if (newType == base_ || !isState(newType) || isOverlay(newType))
             return;
-
-        currentState_->onExit(*ctx_);
-        currentState_ = nullptr;
-
-        auto it = states_.find(newType);
-        if (it != states_.end()) {
-            currentType_ = newType;
-            currentState_ = it->second.get();
-            currentState_->onEnter(*ctx_);
-        }
+        CerekaState old = base_;
+        base_ = newType;
+        table_[index(old)].exit(ctx_);
+        table_[index(newType)].enter(ctx_);
     }
 
-    void pushOverlay(CerekaState overlayType)
+    /**
+     * @brief Open an overlay above the current top. False (and logged) if
+     * the type is not an overlay or the stack is full.
+     */
+    bool pushOverlay(CerekaState overlayType)
     {
-        if (!ctx_)
-            return;
-
-        overlayStack_.push_back({currentType_, currentState_});
-
-        auto it = states_.find(overlayType);
-        if (it != states_.end()) {
-            currentType_ = overlayType;
-            currentState_ = it->second.get();
-            currentState_->onEnter(*ctx_);
+        if (!isOverlay(overlayType) || depth_ == MAX_OVERLAYS) {
+            std::cerr << "[CEREKA] Cannot open overlay " << (int)overlayType << "\n";
+            return false;
         }
+        overlays_[depth_++] = overlayType;
+        table_[index(overlayType)].enter(ctx_);
+        return true;
     }
 
     void popOverlay()
     {
-        if (!ctx_ || overlayStack_.empty())
+        if (depth_ == 0)
             return;
+        CerekaState top = overlays_[--depth_];
+        table_[index(top)].exit(ctx_);
+    }
 
-        if (currentState_) {
-            currentState_->onExit(*ctx_);
-        }
-
-        auto [prevType, prevState] = overlayStack_.back();
-        overlayStack_.pop_back();
-
-        currentType_ = prevType;
-        currentState_ = prevState;
+    void clearOverlays()
+    {
+        while (depth_ > 0)
+            popOverlay();
     }
 
     void update(float dt)
     {
-        if (currentState_ && ctx_) {
-            currentState_->update(dt, *ctx_);
-        }
+        table_[index(currentType())].update(ctx_, dt);
     }
 
-    void draw() const
+    void handleEvent(const CerekaEvent &event)
     {
-        if (currentState_ && ctx_) {
-            currentState_->draw(*ctx_);
-        }
+        table_[index(currentType())].handleEvent(ctx_, event);
     }
 
-    void handleEvent(const CerekaEvent &event)
+    void draw()
     {
-        if (currentState_ && ctx_) {
-            currentState_->handleEvent(event, *ctx_);
-        }
+        table_[index(currentType())].draw(ctx_);
     }
 
+    /**
+     * @brief Draw the base state and the overlays under stack level `level`
+     * (0 = just the base): what the overlay at that level sits on.
+     */
+    void drawBelow(std::size_t level)
+    {
+        table_[index(base_)].draw(ctx_);
+        for (std::size_t i = 0; i < level && i < depth_; ++i)
+            table_[index(overlays_[i])].draw(ctx_);
+    }
+
+    // The state receiving input: the top overlay, else the base state.
     [[nodiscard]] CerekaState currentType() const
     {
-        return currentType_;
+        return depth_ > 0 ? overlays_[depth_ - 1] : base_;
+    }
+
+    [[nodiscard]] CerekaState baseType() const
+    {
+        return base_;
     }
 
     [[nodiscard]] bool hasOverlays() const
     {
-        return !overlayStack_.empty();
+        return depth_ > 0;
+    }
+
+    [[nodiscard]] std::size_t overlayDepth() const
+    {
+        return depth_;
     }
 
    private:
-    IVNStateContext *ctx_ = nullptr;
-    CerekaState currentType_ = CerekaState::Running;
-    IVNState *currentState_ = nullptr;
-    std::unordered_map<CerekaState, std::unique_ptr<IVNState>> states_;
-    std::vector<std::pair<CerekaState, IVNState *>> overlayStack_;
+    struct Hooks {
+        void (*enter)(Context &) = nullptr;
+        void (*exit)(Context &) = nullptr;
+        void (*update)(Context &, float) = nullptr;
+        void (*handleEvent)(Context &, const CerekaEvent &) = nullptr;
+        void (*draw)(Context &) = nullptr;
+        bool overlay = false;
+    };
+
+    static constexpr std::size_t index(CerekaState type)
+    {
+        return (std::size_t)type;
+    }
+
+    static constexpr std::array<Hooks, STATE_COUNT> table_ = [] {
+        std::array<Hooks, STATE_COUNT> t{};
+        ((t[(std::size_t)States::ID] = Hooks{&States::onEnter,
+                                            &States::onExit,
+                                            &States::update,
+                                            &States::handleEvent,
+                                            &States::draw,
+                                            States::OVERLAY}),
+         ...);
+        return t;
+    }();
+
+    static constexpr bool everyStateListed()
+    {
+        for (const Hooks &h : table_)
+            if (!h.enter)
+                return false;
+        return true;
+    }
+
+    Context &ctx_;
+    CerekaState base_ = CerekaState::Running;
+    std::array<CerekaState, MAX_OVERLAYS> overlays_{};
+    std::size_t depth_ = 0;
 };
 
 }  // namespace cereka
@@ -5,58 +5,263 @@
 #include "cereka_states.hpp"
 #include "engine_impl.hpp"
 
+#include <algorithm>
+
 namespace cereka {
 
+namespace {
+
+// The key a KeyDown carries, or the one a gamepad button stands in for:
+// south confirms, east and Start back out, the d-pad moves. 0 otherwise.
+SDL_Keycode pressedKey(const CerekaEvent &e)
+{
+    if (e.type == CerekaEvent::KeyDown)
+        return (SDL_Keycode)e.key;
+    if (e.type != CerekaEvent::GamepadDown)
+        return 0;
+    switch (e.key) {
+        case SDL_GAMEPAD_BUTTON_SOUTH:
+            return SDLK_RETURN;
+        case SDL_GAMEPAD_BUTTON_EAST:
+        case SDL_GAMEPAD_BUTTON_START:
+            return SDLK_ESCAPE;
+        case SDL_GAMEPAD_BUTTON_DPAD_UP:
+            return SDLK_UP;
+        case SDL_GAMEPAD_BUTTON_DPAD_DOWN:
+            return SDLK_DOWN;
+        case SDL_GAMEPAD_BUTTON_DPAD_LEFT:
+            return SDLK_LEFT;
+        case SDL_GAMEPAD_BUTTON_DPAD_RIGHT:
+            return SDLK_RIGHT;
+        default:
+            return 0;
+    }
+}
+
+// Scene and dialogue box: what every in-play state shows.
+void drawPlay(CerekaImpl &engine)
+{
+    engine.DrawStage();
+    engine.DrawDialogueBox();
+}
+
+// Escape during normal play opens the save menu.
+bool openSaveMenuOnEscape(CerekaImpl &engine,
+                          const CerekaEvent &e)
+{
+    if (pressedKey(e) != SDLK_ESCAPE)
+        return false;
+    engine.states.pushOverlay(CerekaState::SaveMenuState);
+    return true;
+}
+
+// Save and load overlays share layout and input; only the action differs.
+void handleSaveOverlayEvent(CerekaImpl &engine,
+                            const CerekaEvent &e,
+                            bool isSaving)
+{
+    ui::WidgetTree &tree = engine.saveUi;
+    switch (pressedKey(e)) {
+        case SDLK_ESCAPE:
+            engine.states.popOverlay();
+            return;
+        case SDLK_LEFT:
+        case SDLK_PAGEUP:
+            engine.TurnSavePage(-1);
+            return;
+        case SDLK_RIGHT:
+        case SDLK_PAGEDOWN:
+            engine.TurnSavePage(1);
+            return;
+        case SDLK_UP:
+        case SDLK_DOWN:
+            tree.MoveFocus(pressedKey(e) == SDLK_UP ? -1 : 1);
+            return;
+        case SDLK_RETURN:
+        case SDLK_SPACE:
+            if (int w = tree.Focused(); w >= 0)
+                engine.ActivateSaveWidget(tree.At(w).id, isSaving);
+            return;
+        default:
+            break;
+    }
+
+    if (e.type == CerekaEvent::MouseWheel)
+        engine.TurnSavePage(e.wheelY > 0.f ? -1 : 1);
+    else if (e.type == CerekaEvent::MouseMove)
+        tree.PointerMove(e.mouseX, e.mouseY);
+    else if (e.type == CerekaEvent::MouseDown)
+        tree.PointerDown(e.mouseX, e.mouseY);
+    else if (e.type == CerekaEvent::MouseUp) {
+        if (int w = tree.PointerUp(e.mouseX, e.mouseY); w >= 0)
+            engine.ActivateSaveWidget(tree.At(w).id, isSaving);
+    }
+}
+
+}  // namespace
+
 // ============================================================================
 // DialogueState — Normal dialogue and tick execution
 // ============================================================================
 
-void DialogueState::update(float dt,
-                           IVNStateContext & /*ctx*/)
+void DialogueState::handleEvent(CerekaImpl &engine,
+                                const CerekaEvent &event)
 {
+    openSaveMenuOnEscape(engine, event);
+}
+
+void DialogueState::draw(CerekaImpl &engine)
+{
+    drawPlay(engine);
+}
+
+// ============================================================================
+// WaitingState — Line shown, waiting for an advance key or click
+// ============================================================================
+
+void WaitingState::handleEvent(CerekaImpl &engine,
+                               const CerekaEvent &event)
+{
+    if (openSaveMenuOnEscape(engine, event))
+        return;
+
+    // The gamepad face button advances whatever the advance keys are. Any
+    // click does too, unless the list names the mouse buttons to use.
+    const auto &keys = engine.uiCfg.advanceKeys;
+    auto listed = [&](SDL_Keycode k) {
+        return std::find(keys.begin(), keys.end(), k) != keys.end();
+    };
+    bool anyClick = std::none_of(keys.begin(), keys.end(), IsMouseKey);
+    bool advance =
+        (event.type == CerekaEvent::MouseDown && (anyClick || listed(MouseKey(event.key)))) ||
+        (event.type == CerekaEvent::GamepadDown && event.key == SDL_GAMEPAD_BUTTON_SOUTH) ||
+        (event.type == CerekaEvent::KeyDown && listed((SDL_Keycode)event.key));
+    if (advance)
+        engine.states.changeState(CerekaState::Running);
+}
+
+void WaitingState::draw(CerekaImpl &engine)
+{
+    drawPlay(engine);
 }
 
 // ============================================================================
 // MenuState — In-game menu with buttons
 // ============================================================================
 
-void MenuState::update(float dt,
-                       IVNStateContext & /*ctx*/)
+void MenuState::onExit(CerekaImpl &engine)
 {
+    engine.ExitMenu();
 }
 
-void MenuState::handleEvent(const CerekaEvent &event,
-                            IVNStateContext &ctx)
+void MenuState::handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event)
 {
+    ui::WidgetTree &tree = engine.menuUi;
+    SDL_Keycode key = pressedKey(event);
+    if (key == SDLK_UP || key == SDLK_DOWN)
+        tree.MoveFocus(key == SDLK_UP ? -1 : 1);
+    else if (key == SDLK_RETURN || key == SDLK_SPACE) {
+        if (int w = tree.Focused(); w >= 0)
+            engine.ChooseMenuOption(tree.At(w).id);
+    }
+    else if (event.type == CerekaEvent::MouseMove)
+        tree.PointerMove(event.mouseX, event.mouseY);
+    else if (event.type == CerekaEvent::MouseDown)
+        tree.PointerDown(event.mouseX, event.mouseY);
+    else if (event.type == CerekaEvent::MouseUp) {
+        if (int w = tree.PointerUp(event.mouseX, event.mouseY); w >= 0)
+            engine.ChooseMenuOption(tree.At(w).id);
+    }
+}
+
+void MenuState::draw(CerekaImpl &engine)
+{
+    engine.DrawStage();
+    engine.DrawMenu();
+    engine.DrawDialogueBox();
 }
 
 // ============================================================================
 // FadeState — Background fade transitions
 // ============================================================================
 
-void FadeState::onEnter(IVNStateContext & /*ctx*/) {}
+void FadeState::update(CerekaImpl &engine,
+                       float dt)
+{
+    if (engine.scene.TickFade(dt))
+        engine.states.changeState(CerekaState::Running);
+}
 
-void FadeState::update(float dt,
-                       IVNStateContext & /*ctx*/)
+void FadeState::draw(CerekaImpl &engine)
 {
+    drawPlay(engine);
+}
+
+// ============================================================================
+// FinishedState / QuitState — last frames before the loop ends
+// ============================================================================
+
+void FinishedState::draw(CerekaImpl &engine)
+{
+    drawPlay(engine);
+}
+
+void QuitState::draw(CerekaImpl &engine)
+{
+    drawPlay(engine);
 }
 
 // ============================================================================
 // SaveMenuState — Save game overlay
 // ============================================================================
 
-void SaveMenuState::handleEvent(const CerekaEvent &event,
-                                IVNStateContext &ctx)
+void SaveMenuState::onEnter(CerekaImpl &engine)
+{
+    engine.CaptureBackdrop(engine.states.overlayDepth() - 1);
+}
+
+void SaveMenuState::onExit(CerekaImpl &engine)
 {
+    engine.ReleaseSlotThumbs();
+}
+
+void SaveMenuState::handleEvent(CerekaImpl &engine,
+                                const CerekaEvent &event)
+{
+    handleSaveOverlayEvent(engine, event, true);
+}
+
+void SaveMenuState::draw(CerekaImpl &engine)
+{
+    engine.DrawBackdrop();
+    engine.DrawSaveLoadOverlay(true);
 }
 
 // ============================================================================
 // LoadMenuState — Load game overlay
 // ============================================================================
 
-void LoadMenuState::handleEvent(const CerekaEvent &event,
-                                IVNStateContext &ctx)
+void LoadMenuState::onEnter(CerekaImpl &engine)
+{
+    engine.CaptureBackdrop(engine.states.overlayDepth() - 1);
+}
+
+void LoadMenuState::onExit(CerekaImpl &engine)
+{
+    engine.ReleaseSlotThumbs();
+}
+
+void LoadMenuState::handleEvent(CerekaImpl &engine,
+                                const CerekaEvent &event)
+{
+    handleSaveOverlayEvent(engine, event, false);
+}
+
+void LoadMenuState::draw(CerekaImpl &engine)
 {
+    engine.DrawBackdrop();
+    engine.DrawSaveLoadOverlay(false);
 }
 
 }  // namespace cereka
@@ -5,12 +5,15 @@
 //
 // States:
 // - DialogueState: Normal dialogue/tick execution
+// - WaitingState: A line is shown; waiting for the player to advance
 // - MenuState: In-game menu with buttons
 // - FadeState: Background fade transitions
-// - SaveMenuState: Save game overlay
-// - LoadMenuState: Load game overlay
 // - FinishedState: Script ended (terminal)
 // - QuitState: Engine shutdown requested
+//
+// Overlays:
+// - SaveMenuState: Save game overlay
+// - LoadMenuState: Load game overlay
 
 #ifndef CEREKA_STATES_HPP
 #    define CEREKA_STATES_HPP
@@ -19,70 +22,99 @@
 
 namespace cereka {
 
+class CerekaImpl;
+
 // ============================================================================
 // DialogueState — Normal dialogue and tick execution
 // ============================================================================
 
-class DialogueState : public VNState<CerekaState::Running> {
-   public:
-    void update(float dt,
-                IVNStateContext &ctx) override;
+struct DialogueState : VNState<CerekaImpl, CerekaState::Running> {
+    static void handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event);
+    static void draw(CerekaImpl &engine);
+};
+
+// ============================================================================
+// WaitingState — Line shown, waiting for an advance key or click
+// ============================================================================
+
+struct WaitingState : VNState<CerekaImpl, CerekaState::WaitingForInput> {
+    static void handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event);
+    static void draw(CerekaImpl &engine);
 };
 
 // ============================================================================
 // MenuState — In-game menu with buttons
 // ============================================================================
 
-class MenuState : public VNState<CerekaState::InMenu> {
-   public:
-    void update(float dt,
-                IVNStateContext &ctx) override;
-    void handleEvent(const CerekaEvent &event,
-                     IVNStateContext &ctx) override;
+struct MenuState : VNState<CerekaImpl, CerekaState::InMenu> {
+    static void onExit(CerekaImpl &engine);
+    static void handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event);
+    static void draw(CerekaImpl &engine);
 };
 
 // ============================================================================
 // FadeState — Background fade transitions
 // ============================================================================
 
-class FadeState : public VNState<CerekaState::Fading> {
-   public:
-    void onEnter(IVNStateContext &ctx) override;
-    void update(float dt,
-                IVNStateContext &ctx) override;
+struct FadeState : VNState<CerekaImpl, CerekaState::Fading> {
+    static void update(CerekaImpl &engine,
+                       float dt);
+    static void draw(CerekaImpl &engine);
 };
 
 // ============================================================================
-// SaveMenuState — Save game overlay
+// FinishedState — Script ended (terminal)
 // ============================================================================
 
-class SaveMenuState : public VNState<CerekaState::SaveMenuState> {
-   public:
-    void handleEvent(const CerekaEvent &event,
-                     IVNStateContext &ctx) override;
+struct FinishedState : VNState<CerekaImpl, CerekaState::Finished> {
+    static void draw(CerekaImpl &engine);
 };
 
 // ============================================================================
-// LoadMenuState — Load game overlay
+// QuitState — Engine shutdown requested
 // ============================================================================
 
-class LoadMenuState : public VNState<CerekaState::LoadMenuState> {
-   public:
-    void handleEvent(const CerekaEvent &event,
-                     IVNStateContext &ctx) override;
+struct QuitState : VNState<CerekaImpl, CerekaState::Quit> {
+    static void draw(CerekaImpl &engine);
 };
 
 // ============================================================================
-// FinishedState — Script ended (terminal)
+// SaveMenuState — Save game overlay
 // ============================================================================
 
-class FinishedState : public VNState<CerekaState::Finished> {};
+struct SaveMenuState : VNState<CerekaImpl, CerekaState::SaveMenuState, true> {
+    static void onEnter(CerekaImpl &engine);
+    static void onExit(CerekaImpl &engine);
+    static void handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event);
+    static void draw(CerekaImpl &engine);
+};
 
 // ============================================================================
-// QuitState — Engine shutdown requested
+// LoadMenuState — Load game overlay
 // ============================================================================
 
-class QuitState : public VNState<CerekaState::Quit> {};
+struct LoadMenuState : VNState<CerekaImpl, CerekaState::LoadMenuState, true> {
+    static void onEnter(CerekaImpl &engine);
+    static void onExit(CerekaImpl &engine);
+    static void handleEvent(CerekaImpl &engine,
+                            const CerekaEvent &event);
+    static void draw(CerekaImpl &engine);
+};
+
+// The engine's machine: one type per CerekaState.
+using EngineStates = CerekaStateMachine<CerekaImpl,
+                                        DialogueState,
+                                        WaitingState,
+                                        MenuState,
+                                        FadeState,
+                                        FinishedState,
+                                        QuitState,
+                                        SaveMenuState,
+                                        LoadMenuState>;
 
 }  // namespace cereka
 #endif  // CEREKA_STATES_HPP
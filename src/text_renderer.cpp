@@ -1,5 +1,6 @@
 #include "text_renderer.hpp"
 #include "Cereka/exceptions.hpp"
+#include "asset_pack.hpp"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <iostream>
@@ -16,7 +17,9 @@ void init_ttf()
 TTF_Font *OpenFont(const std::string &fontPath,
                    int fontSize)
 {
-    TTF_Font *font = TTF_OpenFont(fontPath.c_str(), fontSize);
+    // The font keeps reading glyphs from the stream, which it closes itself.
+    SDL_IOStream *io = asset_pack::Open(fontPath);
+    TTF_Font *font = io ? TTF_OpenFontIO(io, true, (float)fontSize) : nullptr;
     if (!font) {
         std::cerr << "[CEREKA] Failed to open font '" << fontPath << "': "
                   << SDL_GetError() << '\n';
@@ -0,0 +1,159 @@
+#include "texture_cache.hpp"
+#include "image_loader.hpp"
+
+#include <iostream>
+
+namespace cereka {
+
+void TextureCache::Init(SDL_Renderer *r)
+{
+    renderer = r;
+    load = [this](const AssetPrefetcher::Request &req, size_t &bytes) {
+        return decode(req, bytes);
+    };
+    destroy = SDL_DestroyTexture;
+}
+
+void TextureCache::Init(Loader loader,
+                        Destroyer destroyer)
+{
+    renderer = nullptr;
+    load = std::move(loader);
+    destroy = std::move(destroyer);
+}
+
+void TextureCache::Shutdown()
+{
+    for (auto &[key, e] : entries)
+        destroy(e.tex);
+    entries.clear();
+    keyByTexture.clear();
+    lru.clear();
+    resident = 0;
+    renderer = nullptr;
+    load = nullptr;
+    destroy = nullptr;
+}
+
+std::string TextureCache::keyOf(const AssetPrefetcher::Request &req)
+{
+    return req.path + '@' + std::to_string(req.maxW) + 'x' + std::to_string(req.maxH);
+}
+
+SDL_Texture *TextureCache::decode(const AssetPrefetcher::Request &req,
+                                  size_t &bytes)
+{
+    SDL_Texture *tex = nullptr;
+    if (SDL_Surface *surf = prefetcher ? prefetcher->TakeImage(req) : nullptr) {
+        tex = SDL_CreateTextureFromSurface(renderer, surf);
+        SDL_DestroySurface(surf);
+    }
+    else
+        tex = image_loader::LoadTexture(renderer, req.path, req.maxW, req.maxH);
+
+    float w = 0.0f, h = 0.0f;
+    if (tex)
+        SDL_GetTextureSize(tex, &w, &h);
+    bytes = (size_t)w * (size_t)h * 4;
+    return tex;
+}
+
+SDL_Texture *TextureCache::Acquire(const AssetPrefetcher::Request &req)
+{
+    std::string key = keyOf(req);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        Entry &e = it->second;
+        if (e.refs++ == 0)
+            lru.erase(e.idle);
+        return e.tex;
+    }
+
+    size_t bytes = 0;
+    SDL_Texture *tex = load ? load(req, bytes) : nullptr;
+    if (!tex)
+        return nullptr;
+
+    Entry e;
+    e.tex = tex;
+    e.bytes = bytes;
+    e.refs = 1;
+    resident += e.bytes;
+    keyByTexture[tex] = key;
+    entries.emplace(std::move(key), e);
+
+    evictToBudget();
+    return tex;
+}
+
+void TextureCache::Retain(SDL_Texture *tex)
+{
+    if (!tex)
+        return;
+    auto kit = keyByTexture.find(tex);
+    if (kit == keyByTexture.end())
+        return;
+    Entry &e = entries.at(kit->second);
+    if (e.refs++ == 0)
+        lru.erase(e.idle);
+}
+
+void TextureCache::Release(SDL_Texture *tex)
+{
+    if (!tex)
+        return;
+    auto kit = keyByTexture.find(tex);
+    if (kit == keyByTexture.end()) {
+        std::cerr << "[CEREKA] Released a texture the cache does not own\n";
+        return;
+    }
+    Entry &e = entries.at(kit->second);
+    if (e.refs <= 0 || --e.refs > 0)
+        return;
+
+    lru.push_front(kit->second);
+    e.idle = lru.begin();
+    evictToBudget();
+}
+
+bool TextureCache::Contains(const AssetPrefetcher::Request &req) const
+{
+    return entries.count(keyOf(req)) > 0;
+}
+
+void TextureCache::Evict(const std::string &path)
+{
+    std::string prefix = path + '@';
+    for (auto it = lru.begin(); it != lru.end();) {
+        if (!it->starts_with(prefix)) {
+            ++it;
+            continue;
+        }
+        auto e = entries.find(*it);
+        resident -= e->second.bytes;
+        keyByTexture.erase(e->second.tex);
+        destroy(e->second.tex);
+        entries.erase(e);
+        it = lru.erase(it);
+    }
+}
+
+void TextureCache::SetBudget(size_t bytes)
+{
+    budget = bytes;
+    evictToBudget();
+}
+
+void TextureCache::evictToBudget()
+{
+    while (resident > budget && !lru.empty()) {
+        auto it = entries.find(lru.back());
+        lru.pop_back();
+        resident -= it->second.bytes;
+        keyByTexture.erase(it->second.tex);
+        destroy(it->second.tex);
+        entries.erase(it);
+    }
+}
+
+}  // namespace cereka
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "asset_prefetcher.hpp"
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace cereka {
+
+// Shared, reference-counted textures keyed by path and fit box.
+//
+// Acquire hands out a texture and takes a reference; Release drops it.
+// Textures nobody references stay resident so showing the same sprite again
+// is free, and are evicted least-recently-used first once the resident total
+// exceeds the budget. Referenced textures are never evicted, so the budget
+// can be overshot while a scene genuinely needs more.
+class TextureCache {
+   public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 256u * 1024u * 1024u;
+
+    // Make the texture for a miss and report its resident size; free one.
+    using Loader =
+        std::function<SDL_Texture *(const AssetPrefetcher::Request &req, size_t &bytes)>;
+    using Destroyer = std::function<void(SDL_Texture *tex)>;
+
+    // Decode through the prefetcher or image_loader onto r.
+    void Init(SDL_Renderer *r);
+    // Use load and destroy instead of a renderer (tests).
+    void Init(Loader load,
+              Destroyer destroy);
+    // Destroys every texture, referenced or not. Call before the renderer goes.
+    void Shutdown();
+
+    // Misses consult the prefetcher before decoding inline.
+    void AttachPrefetcher(AssetPrefetcher *p) { prefetcher = p; }
+
+    // Returns nullptr (SDL_GetError set) if the image cannot be loaded.
+    SDL_Texture *Acquire(const AssetPrefetcher::Request &req);
+    // Take another reference to a texture Acquire returned.
+    void Retain(SDL_Texture *tex);
+    // Drop one reference. nullptr and unknown textures are ignored.
+    void Release(SDL_Texture *tex);
+
+    bool Contains(const AssetPrefetcher::Request &req) const;
+    // Destroy unreferenced textures loaded from path, at any fit box, so the
+    // next Acquire reads the file again (it was rewritten).
+    void Evict(const std::string &path);
+
+    void SetBudget(size_t bytes);
+    size_t Budget() const { return budget; }
+    size_t ResidentBytes() const { return resident; }
+
+   private:
+    struct Entry {
+        SDL_Texture *tex = nullptr;
+        size_t bytes = 0;
+        int refs = 0;
+        std::list<std::string>::iterator idle;  // position in lru while refs == 0
+    };
+
+    static std::string keyOf(const AssetPrefetcher::Request &req);
+    SDL_Texture *decode(const AssetPrefetcher::Request &req,
+                        size_t &bytes);
+    void evictToBudget();
+
+    SDL_Renderer *renderer = nullptr;
+    Loader load;
+    Destroyer destroy;
+    AssetPrefetcher *prefetcher = nullptr;
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<SDL_Texture *, std::string> keyByTexture;
+    std::list<std::string> lru;  // unreferenced keys, most recently released first
+    size_t budget = DEFAULT_BUDGET_BYTES;
+    size_t resident = 0;
+};
+
+}  // namespace cereka
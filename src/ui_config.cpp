@@ -11,6 +11,7 @@
 
 void Impl::LoadFont(int size)
 {
+    ++themeVersion;  // cached labels were rendered with the old font
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
@@ -21,12 +22,11 @@ void Impl::LoadFont(int size)
         return;
     }
 
-    // Discover the first .ttf/.otf in assets/fonts/
-    std::error_code ec;
-    for (auto &entry : fs::directory_iterator("assets/fonts", ec)) {
-        auto ext = entry.path().extension().string();
+    // Discover the first .ttf/.otf in assets/fonts/ (packed or loose)
+    for (const auto &path : asset_pack::List("assets/fonts")) {
+        auto ext = fs::path(path).extension().string();
         if (ext == ".ttf" || ext == ".otf") {
-            fontPath = entry.path().string();
+            fontPath = path;
             font = text_renderer::OpenFont(fontPath, size);
             if (font)
                 break;
@@ -48,28 +48,86 @@ void Impl::InitConfigManager()
     ctx.reloadFont = [this](int size) { LoadFont(size); };
 
     ctx.loadTexture = [this](SDL_Texture *&tex, const std::string &path) {
-        if (tex) {
-            SDL_DestroyTexture(tex);
-            tex = nullptr;
-        }
+        textures.Release(tex);
+        tex = nullptr;
         if (!path.empty()) {
-            tex = IMG_LoadTexture(renderer, path.c_str());
+            // UI images are drawn at authored size, so no fit box.
+            tex = textures.Acquire({AssetPrefetcher::Request::Kind::Image, path});
             if (!tex) {
                 std::cerr << "[CONFIG] Failed to load texture: " << path << "\n";
             }
         }
     };
 
+    ctx.assignTexture = [this](SDL_Texture *&tex, SDL_Texture *loaded) {
+        textures.Retain(loaded);
+        textures.Release(tex);
+        tex = loaded;
+    };
+
+    ctx.setTextureBudget = [this](int megabytes) {
+        textures.SetBudget((size_t)std::max(megabytes, 0) * 1024 * 1024);
+    };
+
+    ctx.setBgmPredecodeSeconds = [this](float seconds) { audio.SetBgmPredecodeSeconds(seconds); };
+
+    ctx.setSfxBudget = [this](int megabytes) {
+        audio.SetSfxBudget((size_t)std::max(megabytes, 0) * 1024 * 1024);
+    };
+
     configManager.setContext(ctx);
     configManager.initDefaults();
 }
 
 // ============================================================================
-// ApplyUiSet — delegate to ConfigManager
+// UI Patches — ui blocks compiled once per loaded program
 // ============================================================================
 
-void Impl::ApplyUiSet(const std::string &key,
-                      const std::string &val)
+// Parse every UI_SET of the program into a patch and load the textures the
+// patches name, so a theme switch mid-scene is a member write. The compiler
+// already rejected bad values; anything still failing here is skipped.
+void Impl::CompileUiPatches()
 {
-    configManager.apply(key, val);
+    ReleaseUiPatches();
+    const auto &program = scriptInterpreter.program;
+    uiPatchAt.assign(program.size(), -1);
+    for (size_t pc = 0; pc < program.size(); ++pc) {
+        const auto &ins = program[pc];
+        if (ins.op != scenario::Op::UI_SET)
+            continue;
+
+        config::PropertyPatch patch;
+        std::string error;
+        if (!config::compilePatch(ins.a, ins.b, patch, error)) {
+            std::cerr << "[CONFIG] " << error << "\n";
+            continue;
+        }
+        if (patch.def->type == config::PropType::Texture && !patch.value.stringVal.empty()) {
+            patch.value.texture = textures.Acquire(
+                {AssetPrefetcher::Request::Kind::Image, patch.value.stringVal});
+            if (!patch.value.texture)
+                std::cerr << "[CONFIG] Failed to load texture: " << patch.value.stringVal
+                          << "\n";
+        }
+        uiPatchAt[pc] = (int)uiPatches.size();
+        uiPatches.push_back(std::move(patch));
+    }
+}
+
+void Impl::ReleaseUiPatches()
+{
+    for (auto &patch : uiPatches)
+        textures.Release(patch.value.texture);
+    uiPatches.clear();
+    uiPatchAt.clear();
+}
+
+void Impl::ApplyUiPatch(size_t pc)
+{
+    if (pc < uiPatchAt.size() && uiPatchAt[pc] >= 0) {
+        configManager.apply(uiPatches[uiPatchAt[pc]]);
+        ++themeVersion;  // widget layouts pick up the new theme
+        std::erase(uiApplied, pc);
+        uiApplied.push_back(pc);
+    }
 }
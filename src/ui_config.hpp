@@ -10,6 +10,20 @@
 //   Dim::parse("75%") → {0.75, relative=true}
 //   Dim::parse("540")  → {540,  relative=false}
 // ---------------------------------------------------------------------------
+// Mouse buttons in key lists ("mouse1".."mouse3" in scripts): the SDL
+// button number offset past every SDL keycode.
+constexpr SDL_Keycode MOUSE_KEY_BASE = 0x10000000u;
+
+constexpr SDL_Keycode MouseKey(int button)
+{
+    return MOUSE_KEY_BASE + (SDL_Keycode)button;
+}
+
+constexpr bool IsMouseKey(SDL_Keycode key)
+{
+    return key > MOUSE_KEY_BASE && key <= MouseKey(SDL_BUTTON_RIGHT);
+}
+
 struct Dim {
     float value = 0.0f;
     bool relative = false;
@@ -83,6 +97,23 @@ struct UiConfig {
 
     int fontSize = 36;
 
+    // Backdrop of the save / load overlays: the scene beneath is captured
+    // once when one opens, with this baked in.
+    struct Overlay {
+        int dim = 180;  // alpha of black laid over the capture, 0-255
+        int blur = 0;   // 0 = sharp; each step halves the capture once more (max 4)
+    } overlay;
+
+    // Resident budget for unreferenced cached textures (see TextureCache).
+    int textureBudgetMb = 256;
+
+    // BGM up to this long is decoded to PCM; longer tracks stream (see AudioManager).
+    float bgmPredecodeSeconds = 15.0f;
+    // Decoded sound effects kept resident (see AudioManager).
+    int sfxBudgetMb = 32;
+
+    // Keys that advance a shown line; mouse buttons appear as MouseKey(n).
+    // Any click advances unless the list names a mouse button.
     std::vector<SDL_Keycode> advanceKeys = {
         SDLK_SPACE,
         SDLK_RETURN,
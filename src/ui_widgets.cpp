@@ -0,0 +1,375 @@
+#include "ui_widgets.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cereka::ui {
+
+namespace {
+
+bool contains(const SDL_FRect &r,
+              float x,
+              float y)
+{
+    return x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h;
+}
+
+bool intersects(const SDL_FRect &a,
+                const SDL_FRect &b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+bool sameColor(SDL_Color a,
+               SDL_Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+void fill(SDL_Renderer *r,
+          const SDL_FRect &rect,
+          SDL_Color c)
+{
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
+    SDL_RenderFillRect(r, &rect);
+}
+
+}  // namespace
+
+WidgetTree::~WidgetTree()
+{
+    Shutdown();
+}
+
+void WidgetTree::Init(SDL_Renderer *r,
+                      TextRenderer text)
+{
+    renderer = r;
+    renderText = std::move(text);
+}
+
+void WidgetTree::Shutdown()
+{
+    Clear();
+    if (layer)
+        SDL_DestroyTexture(layer);
+    layer = nullptr;
+    layerW = layerH = 0;
+    layoutKey = 0;
+}
+
+void WidgetTree::Clear()
+{
+    for (Widget &w : widgets)
+        destroyLabel(w);
+    widgets.clear();
+    fullRepaint = true;
+}
+
+int WidgetTree::Add(Widget w)
+{
+    widgets.push_back(std::move(w));
+    int i = (int)widgets.size() - 1;
+    touch(i);
+    return i;
+}
+
+void WidgetTree::SetText(int i,
+                         const std::string &text)
+{
+    if (widgets[i].text == text)
+        return;
+    widgets[i].text = text;
+    touch(i);
+}
+
+void WidgetTree::SetVisible(int i,
+                            bool visible)
+{
+    if (widgets[i].visible == visible)
+        return;
+    widgets[i].visible = visible;
+    // Children appear and disappear with it.
+    for (int j = i; j < (int)widgets.size(); ++j) {
+        int p = j;
+        while (p != -1 && p != i)
+            p = widgets[p].parent;
+        if (p == i)
+            touch(j);
+    }
+}
+
+void WidgetTree::SetRect(int i,
+                         const SDL_FRect &rect)
+{
+    const SDL_FRect &old = widgets[i].rect;
+    if (old.x == rect.x && old.y == rect.y && old.w == rect.w && old.h == rect.h)
+        return;
+    touch(i);
+    widgets[i].rect = rect;
+    touch(i);
+}
+
+void WidgetTree::SetImage(int i,
+                          SDL_Texture *image)
+{
+    if (widgets[i].style.image == image)
+        return;
+    widgets[i].style.image = image;
+    touch(i);
+}
+
+// ---------------------------------------------------------------------------
+// Input
+// ---------------------------------------------------------------------------
+
+int WidgetTree::HitTest(float x,
+                        float y) const
+{
+    for (int i = (int)widgets.size() - 1; i >= 0; --i) {
+        const Widget &w = widgets[i];
+        if (w.kind == Widget::Kind::Button && shown(i) && contains(w.rect, x, y))
+            return i;
+    }
+    return -1;
+}
+
+bool WidgetTree::PointerMove(float x,
+                             float y)
+{
+    int hit = HitTest(x, y);
+    bool changed = false;
+    for (int i = 0; i < (int)widgets.size(); ++i) {
+        bool hover = i == hit;
+        if (widgets[i].hover != hover) {
+            widgets[i].hover = hover;
+            touch(i);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool WidgetTree::PointerDown(float x,
+                             float y)
+{
+    int hit = HitTest(x, y);
+    if (hit < 0)
+        return false;
+    for (int i = 0; i < (int)widgets.size(); ++i) {
+        bool on = i == hit;
+        if (widgets[i].pressed != on || widgets[i].focused != on) {
+            widgets[i].pressed = widgets[i].focused = on;
+            touch(i);
+        }
+    }
+    return true;
+}
+
+int WidgetTree::PointerUp(float x,
+                          float y)
+{
+    int pressed = -1;
+    for (int i = 0; i < (int)widgets.size(); ++i) {
+        if (widgets[i].pressed) {
+            widgets[i].pressed = false;
+            touch(i);
+            pressed = i;
+        }
+    }
+    return pressed >= 0 && pressed == HitTest(x, y) ? pressed : -1;
+}
+
+void WidgetTree::MoveFocus(int delta)
+{
+    std::vector<int> buttons;
+    for (int i = 0; i < (int)widgets.size(); ++i)
+        if (widgets[i].kind == Widget::Kind::Button && shown(i))
+            buttons.push_back(i);
+    if (buttons.empty())
+        return;
+
+    int n = (int)buttons.size();
+    auto cur = std::find(buttons.begin(), buttons.end(), Focused());
+    int next = cur == buttons.end() ? (delta > 0 ? 0 : n - 1)
+                                    : (((int)(cur - buttons.begin()) + delta) % n + n) % n;
+    for (int i = 0; i < (int)widgets.size(); ++i) {
+        bool on = i == buttons[next];
+        if (widgets[i].focused != on) {
+            widgets[i].focused = on;
+            touch(i);
+        }
+    }
+}
+
+int WidgetTree::Focused() const
+{
+    for (int i = 0; i < (int)widgets.size(); ++i)
+        if (widgets[i].focused && shown(i))
+            return i;
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Drawing
+// ---------------------------------------------------------------------------
+
+void WidgetTree::Draw(int screenW,
+                      int screenH)
+{
+    if (!renderer)
+        return;
+
+    if (!layer || layerW != screenW || layerH != screenH) {
+        if (layer)
+            SDL_DestroyTexture(layer);
+        layer = SDL_CreateTexture(
+            renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, screenW, screenH);
+        layerW = screenW;
+        layerH = screenH;
+        fullRepaint = true;
+    }
+
+    // No render targets on this renderer: paint straight to the screen.
+    if (!layer) {
+        for (int i = 0; i < (int)widgets.size(); ++i)
+            if (shown(i))
+                paint(widgets[i]);
+        return;
+    }
+
+    if (fullRepaint) {
+        dirty = {0.0f, 0.0f, (float)screenW, (float)screenH};
+        hasDirty = true;
+        fullRepaint = false;
+    }
+    if (hasDirty) {
+        SDL_Texture *prev = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, layer);
+        SDL_Rect clip{(int)std::floor(dirty.x),
+                      (int)std::floor(dirty.y),
+                      (int)std::ceil(dirty.w) + 1,
+                      (int)std::ceil(dirty.h) + 1};
+        SDL_SetRenderClipRect(renderer, &clip);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(renderer, nullptr);
+        for (int i = 0; i < (int)widgets.size(); ++i)
+            if (shown(i) && intersects(widgets[i].rect, dirty))
+                paint(widgets[i]);
+        SDL_SetRenderClipRect(renderer, nullptr);
+        SDL_SetRenderTarget(renderer, prev);
+        hasDirty = false;
+    }
+
+    // The layer holds colors already multiplied by their alpha.
+    SDL_SetTextureBlendMode(layer, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    SDL_RenderTexture(renderer, layer, nullptr, nullptr);
+}
+
+void WidgetTree::paint(Widget &w)
+{
+    if (w.kind != Widget::Kind::Label) {
+        bool hoverArt = w.kind == Widget::Kind::Button && w.hover && w.style.hoverImage;
+        SDL_Texture *image = hoverArt ? w.style.hoverImage : w.style.image;
+        if (image)
+            SDL_RenderTexture(renderer, image, nullptr, &w.rect);
+        else if (w.style.fill.a > 0)
+            fill(renderer, w.rect, w.style.fill);
+
+        if (w.kind == Widget::Kind::Button) {
+            // Without hover art, tint: lighter under the pointer, darker held.
+            if (w.pressed && w.hover)
+                fill(renderer, w.rect, {0, 0, 0, 60});
+            else if (w.hover && !hoverArt)
+                fill(renderer, w.rect, {255, 255, 255, 40});
+            if (w.focused) {
+                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
+                SDL_RenderRect(renderer, &w.rect);
+            }
+        }
+    }
+
+    SDL_Texture *label = labelFor(w);
+    if (!label)
+        return;
+    float tw = 0.0f, th = 0.0f;
+    SDL_GetTextureSize(label, &tw, &th);
+    float room = w.rect.w - 2.0f * w.padX;
+    float scale = w.shrinkToFit && tw > room && room > 0.0f ? room / tw : 1.0f;
+    tw *= scale;
+    th *= scale;
+    SDL_FRect dst{w.alignX == Widget::Align::Start ? w.rect.x + w.padX
+                                                   : w.rect.x + (w.rect.w - tw) * 0.5f,
+                  w.alignY == Widget::Align::Start ? w.rect.y + w.padY
+                                                   : w.rect.y + (w.rect.h - th) * 0.5f,
+                  tw,
+                  th};
+    SDL_RenderTexture(renderer, label, nullptr, &dst);
+}
+
+SDL_Texture *WidgetTree::labelFor(Widget &w)
+{
+    if (w.label && w.labelText == w.text && sameColor(w.labelColor, w.style.text))
+        return w.label;
+    destroyLabel(w);
+    if (w.text.empty() || !renderText)
+        return nullptr;
+    w.label = renderText(w.text, w.style.text);
+    w.labelText = w.text;
+    w.labelColor = w.style.text;
+    return w.label;
+}
+
+void WidgetTree::destroyLabel(Widget &w)
+{
+    if (w.label)
+        SDL_DestroyTexture(w.label);
+    w.label = nullptr;
+    w.labelText.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+std::uint64_t WidgetTree::KeyOf(std::initializer_list<std::uint64_t> parts)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for (std::uint64_t p : parts)
+        h = (h ^ p) * 1099511628211ull;
+    return h | 1;
+}
+
+bool WidgetTree::shown(int i) const
+{
+    for (; i != -1; i = widgets[i].parent)
+        if (!widgets[i].visible)
+            return false;
+    return true;
+}
+
+void WidgetTree::touch(int i)
+{
+    addDirty(widgets[i].rect);
+}
+
+void WidgetTree::addDirty(const SDL_FRect &r)
+{
+    if (r.w <= 0.0f || r.h <= 0.0f)
+        return;
+    if (!hasDirty) {
+        dirty = r;
+        hasDirty = true;
+        return;
+    }
+    float x0 = std::min(dirty.x, r.x);
+    float y0 = std::min(dirty.y, r.y);
+    float x1 = std::max(dirty.x + dirty.w, r.x + r.w);
+    float y1 = std::max(dirty.y + dirty.h, r.y + r.h);
+    dirty = {x0, y0, x1 - x0, y1 - y0};
+}
+
+}  // namespace cereka::ui
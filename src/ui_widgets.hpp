@@ -0,0 +1,140 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace cereka::ui {
+
+// How a widget is painted. Images stretch to the widget's rect and replace
+// the fill; hoverImage is used instead while a button is hovered.
+struct Style {
+    SDL_Color fill = {0, 0, 0, 0};
+    SDL_Texture *image = nullptr;       // not owned
+    SDL_Texture *hoverImage = nullptr;  // not owned
+    SDL_Color text = {255, 255, 255, 255};
+};
+
+struct Widget {
+    enum class Kind {
+        Box,     // fill / image only
+        Label,   // text only
+        Button,  // box + centered label; hover, press and focus
+    };
+    enum class Align { Start, Center };
+
+    Kind kind = Kind::Box;
+    int id = 0;       // caller's meaning: menu choice, save slot, ...
+    int parent = -1;  // hidden with its parent
+    SDL_FRect rect{};
+    Style style;
+
+    std::string text;
+    Align alignX = Align::Center;
+    Align alignY = Align::Center;
+    float padX = 0.0f;  // label offset from the rect edge when aligned to Start
+    float padY = 0.0f;
+    bool shrinkToFit = false;  // scale a label wider than the rect down to fit
+
+    bool visible = true;
+    bool hover = false;
+    bool pressed = false;
+    bool focused = false;
+
+    // Rendered label, rebuilt only when the text or its color changes
+    SDL_Texture *label = nullptr;
+    std::string labelText;
+    SDL_Color labelColor{};
+};
+
+// A retained set of widgets for one screen (menu, dialogue box, save
+// overlay). The screen builds it once per layout change; afterwards input
+// updates widget state and Draw repaints only what changed.
+//
+// Widgets are painted in the order they were added into a cached layer the
+// size of the screen. Changing a widget marks its old and new rect dirty;
+// Draw clears and repaints the dirty area of the layer, then composites the
+// layer with a single copy.
+class WidgetTree {
+   public:
+    using TextRenderer = std::function<SDL_Texture *(const std::string &text, SDL_Color color)>;
+
+    WidgetTree() = default;
+    WidgetTree(const WidgetTree &) = delete;
+    WidgetTree &operator=(const WidgetTree &) = delete;
+    ~WidgetTree();
+
+    void Init(SDL_Renderer *r,
+              TextRenderer renderText);
+    // Frees labels and the layer. Call before the renderer goes.
+    void Shutdown();
+
+    // Drop every widget (and its label) to build a new layout.
+    void Clear();
+    int Add(Widget w);
+    size_t Size() const { return widgets.size(); }
+    const Widget &At(int i) const { return widgets[i]; }
+
+    // Setters repaint the widget only if the value differs.
+    void SetText(int i,
+                 const std::string &text);
+    void SetVisible(int i,
+                    bool visible);
+    void SetRect(int i,
+                 const SDL_FRect &rect);
+    void SetImage(int i,
+                  SDL_Texture *image);
+
+    // Layout identity: Build functions compare it to decide whether the tree
+    // must be rebuilt (theme, resolution or content changed).
+    std::uint64_t LayoutKey() const { return layoutKey; }
+    void SetLayoutKey(std::uint64_t key) { layoutKey = key; }
+    // Combine what a layout depends on into one key (never 0).
+    static std::uint64_t KeyOf(std::initializer_list<std::uint64_t> parts);
+
+    // Topmost visible button under the point, or -1.
+    int HitTest(float x,
+                float y) const;
+    // Input; each returns true if any widget state changed.
+    bool PointerMove(float x,
+                     float y);
+    bool PointerDown(float x,
+                     float y);
+    // The button pressed and released under the pointer, or -1.
+    int PointerUp(float x,
+                  float y);
+    // Move keyboard focus among visible buttons (+1 / -1, wrapping).
+    void MoveFocus(int delta);
+    int Focused() const;
+
+    // The layer's contents were lost (device reset); repaint everything.
+    void Invalidate() { fullRepaint = true; }
+
+    void Draw(int screenW,
+              int screenH);
+
+   private:
+    bool shown(int i) const;
+    void touch(int i);
+    void addDirty(const SDL_FRect &r);
+    void paint(Widget &w);
+    SDL_Texture *labelFor(Widget &w);
+    void destroyLabel(Widget &w);
+
+    SDL_Renderer *renderer = nullptr;
+    TextRenderer renderText;
+    std::vector<Widget> widgets;
+    std::uint64_t layoutKey = 0;
+
+    SDL_Texture *layer = nullptr;
+    int layerW = 0;
+    int layerH = 0;
+    bool fullRepaint = true;
+    bool hasDirty = false;
+    SDL_FRect dirty{};  // union of rects to repaint
+};
+
+}  // namespace cereka::ui
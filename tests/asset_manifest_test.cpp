@@ -0,0 +1,136 @@
+// asset_manifest_test.cpp — Tests for the compile-time asset manifest
+//
+// Region splitting, per-label sets and the missing-file check.
+
+#include "archive/crpak.hpp"
+#include "archive/crtex.hpp"
+#include "asset_pack.hpp"
+#include "compiler/asset_manifest.hpp"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using namespace cereka;
+using namespace cereka::scenario;
+
+namespace {
+
+std::vector<std::string> pathsOf(const AssetManifest &m,
+                                 const std::vector<size_t> &indices)
+{
+    std::vector<std::string> out;
+    for (size_t i : indices)
+        out.push_back(m.assets[i].path);
+    return out;
+}
+
+}  // namespace
+
+TEST(AssetManifestTest,
+     RegionsSplitAtLabelsAndControlFlow)
+{
+    std::vector<Instruction> program = {
+        {Op::BG, "room.png"},
+        {Op::PLAY_BGM, "theme.ogg"},
+        {Op::JUMP, "next"},
+        {Op::LABEL, "next"},
+        {Op::CHAR, "a", "a.png", "left"},
+        {Op::IF_EQ, "flag", "1"},
+        {Op::PLAY_SFX, "door.wav"},
+        {Op::ENDIF},
+        {Op::END},
+    };
+    AssetManifest m = BuildAssetManifest(program);
+
+    ASSERT_EQ(m.regions.size(), 4u);
+    EXPECT_EQ(m.regions[0].end, 3u);
+    EXPECT_EQ(pathsOf(m, m.regions[0].assets),
+              (std::vector<std::string>{"assets/bg/room.png", "assets/sounds/theme.ogg"}));
+    EXPECT_EQ(pathsOf(m, m.regions[1].assets),
+              (std::vector<std::string>{"assets/characters/a.png"}));
+    EXPECT_EQ(pathsOf(m, m.regions[2].assets),
+              (std::vector<std::string>{"assets/sounds/door.wav"}));
+
+    EXPECT_EQ(m.RegionAt(0), &m.regions[0]);
+    EXPECT_EQ(m.RegionAt(4), &m.regions[1]);
+    EXPECT_EQ(m.RegionAt(8), &m.regions[3]);
+    EXPECT_EQ(m.RegionAt(9), nullptr);
+}
+
+TEST(AssetManifestTest,
+     LabelSetsRunToTheNextLabelAndDeduplicate)
+{
+    std::vector<Instruction> program = {
+        {Op::BG, "title.png"},
+        {Op::LABEL, "ch1"},
+        {Op::BG, "room.png"},
+        {Op::MENU},
+        {Op::BG, "menu.png"},
+        {Op::BUTTON, "Go", "ch2"},
+        {Op::FADE, "room.png", "1.0"},
+        {Op::LABEL, "ch2"},
+        {Op::PRELOAD_SFX, "hit.wav"},
+        {Op::PLAY_SFX, "hit.wav"},
+        {Op::END},
+    };
+    AssetManifest m = BuildAssetManifest(program);
+
+    EXPECT_EQ(m.assets.size(), 4u);
+    ASSERT_NE(m.LabelAssets("ch1"), nullptr);
+    EXPECT_EQ(pathsOf(m, *m.LabelAssets("ch1")),
+              (std::vector<std::string>{"assets/bg/room.png", "assets/bg/menu.png"}));
+    EXPECT_EQ(pathsOf(m, *m.LabelAssets("ch2")),
+              (std::vector<std::string>{"assets/sounds/hit.wav"}));
+    EXPECT_EQ(m.LabelAssets("nowhere"), nullptr);
+}
+
+TEST(AssetManifestTest,
+     ReportsFilesThatDoNotExist)
+{
+    std::vector<Instruction> program = {
+        {Op::BG, "definitely_not_here.png"},
+        {Op::END},
+    };
+    program[0].srcLine = 7;
+    AssetManifest m = BuildAssetManifest(program);
+
+    auto missing = MissingAssets(m);
+    ASSERT_EQ(missing.size(), 1u);
+    EXPECT_EQ(missing[0]->path, "assets/bg/definitely_not_here.png");
+    EXPECT_EQ(missing[0]->srcLine, 7);
+}
+
+TEST(AssetManifestTest,
+     PackagedImagesCountAsPresent)
+{
+    // A packaged build ships room.png only as its pre-decoded copy.
+    fs::path dir = fs::temp_directory_path() / "cereka_manifest_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::vector<std::uint8_t> pixels(4 * 2 * 2, 0xff), encoded;
+    crtex::Encode(pixels.data(), 2, 2, 2 * 4, true, encoded);
+    fs::path tex = dir / "room.crtex";
+    std::ofstream(tex, std::ios::binary)
+        .write((const char *)encoded.data(), (std::streamsize)encoded.size());
+    std::string packed = std::string("assets/bg/room.png") + crtex::EXTENSION;
+    fs::path archive = dir / crpak::DEFAULT_NAME;
+    std::string error;
+    ASSERT_TRUE(crpak::Write(archive, {{packed, tex}}, error)) << error;
+
+    std::vector<Instruction> program = {
+        {Op::BG, "room.png"},
+        {Op::BG, "hall.png"},
+        {Op::END},
+    };
+    AssetManifest m = BuildAssetManifest(program);
+
+    ASSERT_TRUE(asset_pack::Mount(archive.string()));
+    auto missing = MissingAssets(m);
+    asset_pack::Unmount();
+    fs::remove_all(dir);
+
+    ASSERT_EQ(missing.size(), 1u);
+    EXPECT_EQ(missing[0]->path, "assets/bg/hall.png");
+}
@@ -0,0 +1,70 @@
+// asset_prefetcher_test.cpp — Tests for the look-ahead program scan
+//
+// Only ScanAhead is covered; decoding needs real assets and a mixer.
+
+#include "asset_prefetcher.hpp"
+#include <gtest/gtest.h>
+
+using cereka::AssetPrefetcher;
+using cereka::scenario::Instruction;
+using cereka::scenario::Op;
+
+namespace {
+
+std::unordered_map<std::string, size_t> labelsOf(const std::vector<Instruction> &program)
+{
+    std::unordered_map<std::string, size_t> labels;
+    for (size_t i = 0; i < program.size(); ++i)
+        if (program[i].op == Op::LABEL)
+            labels[program[i].a] = i;
+    return labels;
+}
+
+}  // namespace
+
+TEST(AssetPrefetcherTest,
+     ScanFollowsJumpsAndStopsAtEnd)
+{
+    std::vector<Instruction> program = {
+        {Op::BG, "room.png"},
+        {Op::SAY, "a", "hi"},
+        {Op::JUMP, "next"},
+        {Op::BG, "skipped.png"},
+        {Op::LABEL, "next"},
+        {Op::CHAR, "a", "a.png", "left"},
+        {Op::PLAY_BGM, "theme.ogg"},
+        {Op::END},
+        {Op::BG, "after_end.png"},
+    };
+    auto hits = AssetPrefetcher::ScanAhead(program, labelsOf(program), 0);
+    EXPECT_EQ(hits, (std::vector<size_t>{0, 5, 6}));
+}
+
+TEST(AssetPrefetcherTest,
+     ScanVisitsEveryMenuBranch)
+{
+    std::vector<Instruction> program = {
+        {Op::MENU},
+        {Op::BG, "menu.png"},
+        {Op::BUTTON, "Left", "left"},
+        {Op::BUTTON, "Right", "right"},
+        {Op::LABEL, "left"},
+        {Op::BG, "left.png"},
+        {Op::END},
+        {Op::LABEL, "right"},
+        {Op::PLAY_SFX, "door.wav"},
+        {Op::END},
+    };
+    auto hits = AssetPrefetcher::ScanAhead(program, labelsOf(program), 0);
+    EXPECT_EQ(hits, (std::vector<size_t>{1, 5, 8}));
+}
+
+TEST(AssetPrefetcherTest,
+     ScanRespectsAssetBudget)
+{
+    std::vector<Instruction> program;
+    for (int i = 0; i < 10; ++i)
+        program.push_back({Op::BG, "bg" + std::to_string(i) + ".png"});
+    auto hits = AssetPrefetcher::ScanAhead(program, labelsOf(program), 2, 512, 3);
+    EXPECT_EQ(hits, (std::vector<size_t>{2, 3, 4}));
+}
@@ -0,0 +1,35 @@
+// audio_loader_test.cpp — Tests for the choice between streaming a music
+// track and decoding it up front
+
+#include "audio_loader.hpp"
+#include <gtest/gtest.h>
+
+using cereka::audio_loader::ShouldPredecode;
+
+TEST(AudioLoaderTest,
+     UnknownLengthStreams)
+{
+    EXPECT_FALSE(ShouldPredecode(0.0, 30.0f));
+    EXPECT_FALSE(ShouldPredecode(-1.0, 30.0f));
+}
+
+TEST(AudioLoaderTest,
+     ShortTrackIsPredecoded)
+{
+    EXPECT_TRUE(ShouldPredecode(4.5, 30.0f));
+    EXPECT_TRUE(ShouldPredecode(30.0, 30.0f));
+}
+
+TEST(AudioLoaderTest,
+     LongTrackStreams)
+{
+    EXPECT_FALSE(ShouldPredecode(30.5, 30.0f));
+    EXPECT_FALSE(ShouldPredecode(240.0, 30.0f));
+}
+
+TEST(AudioLoaderTest,
+     ZeroLimitStreamsEverything)
+{
+    EXPECT_FALSE(ShouldPredecode(0.1, 0.0f));
+    EXPECT_FALSE(ShouldPredecode(240.0, 0.0f));
+}
@@ -124,6 +124,62 @@ TEST_F(ConfigManagerTest,
     EXPECT_EQ(def->type, PropType::Color);
 }
 
+TEST_F(ConfigManagerTest,
+       CompilePatchRejectsBadValues)
+{
+    PropertyPatch patch;
+    std::string error;
+    EXPECT_FALSE(compilePatch("textbox.colour", "0 0 0", patch, error));
+    EXPECT_FALSE(compilePatch("textbox.color", "0 0 300", patch, error));
+    EXPECT_FALSE(compilePatch("textbox.color", "0 0", patch, error));
+    EXPECT_FALSE(compilePatch("textbox.y", "75%%", patch, error));
+    EXPECT_FALSE(compilePatch("namebox.w", "250px", patch, error));
+    EXPECT_FALSE(compilePatch("font.size", "4.5", patch, error));
+    EXPECT_FALSE(compilePatch("advance_keys", "space enterr", patch, error));
+    EXPECT_NE(error.find("advance_keys"), std::string::npos);
+}
+
+TEST_F(ConfigManagerTest,
+       ApplyCompiledPatch)
+{
+    PropertyPatch color, y, keys;
+    std::string error;
+    ASSERT_TRUE(compilePatch("textbox.color", "10 20 30", color, error)) << error;
+    ASSERT_TRUE(compilePatch("textbox.y", " 60% ", y, error)) << error;
+    ASSERT_TRUE(compilePatch("advance_keys", "enter tab", keys, error)) << error;
+
+    cm.apply(color);
+    cm.apply(y);
+    cm.apply(keys);
+    EXPECT_EQ(cm.getValue("textbox.color"), "10 20 30 255");
+    EXPECT_EQ(cm.getValue("textbox.y"), "60%");
+    EXPECT_EQ(cm.getValue("advance_keys"), "enter tab");
+}
+
+TEST_F(ConfigManagerTest,
+       KeyListsAcceptMouseButtons)
+{
+    PropertyPatch keys, bad;
+    std::string error;
+    ASSERT_TRUE(compilePatch("advance_keys", "space enter mouse1", keys, error)) << error;
+    EXPECT_FALSE(compilePatch("advance_keys", "click", bad, error));
+    // The error lists the names that are accepted, mouse buttons included.
+    EXPECT_NE(error.find("mouse1 mouse2 mouse3"), std::string::npos) << error;
+    EXPECT_FALSE(compilePatch("advance_keys", "mouse4", bad, error));
+
+    cm.apply(keys);
+    EXPECT_EQ(cm.getValue("advance_keys"), "space enter mouse1");
+    EXPECT_TRUE(IsMouseKey(MouseKey(SDL_BUTTON_LEFT)));
+    EXPECT_FALSE(IsMouseKey(SDLK_SPACE));
+}
+
+TEST_F(ConfigManagerTest,
+       BadValueLeavesPropertyUnchanged)
+{
+    cm.apply("textbox.color", "red");
+    EXPECT_EQ(cm.getValue("textbox.color"), "0 0 0 160");
+}
+
 TEST_F(ConfigManagerTest,
        PropertyValueParsing)
 {
@@ -0,0 +1,98 @@
+// crpak_test.cpp — Tests for the .crpak asset archive format
+//
+// Round-trips files through crpak::Write and reads them back with crpak::View.
+
+#include "archive/crpak.hpp"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+using namespace cereka;
+
+class CrpakTest : public ::testing::Test {
+   protected:
+    void SetUp() override
+    {
+        dir = fs::temp_directory_path() / "cereka_crpak_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override { fs::remove_all(dir); }
+
+    fs::path writeFile(const std::string &name,
+                       const std::string &content)
+    {
+        fs::path p = dir / name;
+        std::ofstream(p, std::ios::binary) << content;
+        return p;
+    }
+
+    std::vector<std::uint8_t> readArchive(const fs::path &p)
+    {
+        std::ifstream f(p, std::ios::binary);
+        return {std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+    }
+
+    fs::path dir;
+};
+
+TEST_F(CrpakTest,
+       RoundTripFindsEveryFile)
+{
+    std::vector<crpak::WriteItem> items = {
+        {"assets/sounds/door.wav", writeFile("door.wav", "RIFFdata")},
+        {"assets/bg/room.png", writeFile("room.png", "png-bytes")},
+        {"assets/characters/a.png", writeFile("a.png", "x")},
+    };
+    fs::path archive = dir / "assets.crpak";
+    std::string error;
+    ASSERT_TRUE(crpak::Write(archive, items, error)) << error;
+
+    std::vector<std::uint8_t> bytes = readArchive(archive);
+    crpak::View view;
+    ASSERT_TRUE(view.Open(bytes.data(), bytes.size()));
+    EXPECT_EQ(view.Count(), 3u);
+
+    const crpak::Entry *e = view.Find("assets/bg/room.png");
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->offset % crpak::ALIGNMENT, 0u);
+    EXPECT_EQ(std::string((const char *)view.Payload(*e), e->size), "png-bytes");
+
+    e = view.Find("assets/sounds/door.wav");
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(std::string((const char *)view.Payload(*e), e->size), "RIFFdata");
+
+    EXPECT_EQ(view.Find("assets/bg/missing.png"), nullptr);
+    EXPECT_EQ(view.Find("assets/bg"), nullptr);
+}
+
+TEST_F(CrpakTest,
+       RejectsDuplicatePaths)
+{
+    fs::path src = writeFile("a.png", "x");
+    std::string error;
+    EXPECT_FALSE(crpak::Write(dir / "dup.crpak", {{"assets/a.png", src}, {"assets/a.png", src}},
+                              error));
+    EXPECT_FALSE(fs::exists(dir / "dup.crpak"));
+}
+
+TEST_F(CrpakTest,
+       RejectsTruncatedArchive)
+{
+    std::string error;
+    fs::path archive = dir / "assets.crpak";
+    ASSERT_TRUE(crpak::Write(archive, {{"assets/a.png", writeFile("a.png", "abc")}}, error));
+
+    std::vector<std::uint8_t> bytes = readArchive(archive);
+    crpak::View view;
+    EXPECT_FALSE(view.Open(bytes.data(), bytes.size() - 1));
+    EXPECT_FALSE(view.Open(bytes.data(), sizeof(crpak::Header) - 1));
+
+    bytes[0] = 'X';
+    EXPECT_FALSE(view.Open(bytes.data(), bytes.size()));
+}
@@ -0,0 +1,110 @@
+// crtex_test.cpp — Tests for the pre-decoded texture format
+//
+// Covers the LZ4 block codec and the header / pixel round trip.
+
+#include "archive/crtex.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace cereka::crtex;
+
+namespace {
+
+std::vector<std::uint8_t> roundTrip(const std::vector<std::uint8_t> &src)
+{
+    std::vector<std::uint8_t> packed;
+    Lz4Compress(src.data(), src.size(), packed);
+    std::vector<std::uint8_t> out(src.size());
+    EXPECT_TRUE(Lz4Decompress(packed.data(), packed.size(), out.data(), out.size()));
+    return out;
+}
+
+}  // namespace
+
+TEST(CrtexTest,
+     Lz4RoundTripsRepetitiveAndRandomData)
+{
+    std::vector<std::uint8_t> flat(100000, 0x7f);
+    EXPECT_EQ(roundTrip(flat), flat);
+
+    std::vector<std::uint8_t> noise(70000);
+    std::mt19937 rng(42);
+    for (auto &b : noise)
+        b = (std::uint8_t)rng();
+    EXPECT_EQ(roundTrip(noise), noise);
+
+    std::vector<std::uint8_t> tiny = {1, 2, 3};
+    EXPECT_EQ(roundTrip(tiny), tiny);
+    EXPECT_EQ(roundTrip({}), std::vector<std::uint8_t>{});
+}
+
+TEST(CrtexTest,
+     Lz4CompressesFlatData)
+{
+    std::vector<std::uint8_t> flat(1 << 20, 0);
+    std::vector<std::uint8_t> packed;
+    Lz4Compress(flat.data(), flat.size(), packed);
+    EXPECT_LT(packed.size(), flat.size() / 100);
+}
+
+TEST(CrtexTest,
+     Lz4RejectsWrongOutputSize)
+{
+    std::vector<std::uint8_t> src(1000, 9);
+    std::vector<std::uint8_t> packed;
+    Lz4Compress(src.data(), src.size(), packed);
+    std::vector<std::uint8_t> out(999);
+    EXPECT_FALSE(Lz4Decompress(packed.data(), packed.size(), out.data(), out.size()));
+}
+
+TEST(CrtexTest,
+     EncodeDecodeHonoursPitch)
+{
+    // 3x2 image stored with 4 bytes of row padding.
+    const int w = 3, h = 2, pitch = w * 4 + 4;
+    std::vector<std::uint8_t> src(pitch * h, 0xee);
+    for (int y = 0; y < h; ++y)
+        for (int i = 0; i < w * 4; ++i)
+            src[y * pitch + i] = (std::uint8_t)(y * 16 + i);
+
+    for (bool compress : {false, true}) {
+        std::vector<std::uint8_t> file;
+        Encode(src.data(), w, h, pitch, compress, file);
+
+        Header header;
+        ASSERT_TRUE(ReadHeader(file.data(), file.size(), header));
+        EXPECT_EQ(header.width, 3u);
+        EXPECT_EQ(header.height, 2u);
+
+        std::vector<std::uint8_t> dst(w * 4 * h);
+        ASSERT_TRUE(DecodePixels(file.data(), file.size(), dst.data(), w * 4));
+        for (int y = 0; y < h; ++y)
+            for (int i = 0; i < w * 4; ++i)
+                EXPECT_EQ(dst[y * w * 4 + i], src[y * pitch + i]);
+    }
+}
+
+TEST(CrtexTest,
+     LargeFlatImageIsStoredCompressed)
+{
+    std::vector<std::uint8_t> px(256 * 256 * 4, 0x40);
+    std::vector<std::uint8_t> file;
+    Encode(px.data(), 256, 256, 256 * 4, true, file);
+
+    Header header;
+    ASSERT_TRUE(ReadHeader(file.data(), file.size(), header));
+    EXPECT_EQ(header.compression, Compression::Lz4);
+
+    file.pop_back();
+    EXPECT_FALSE(ReadHeader(file.data(), file.size(), header));
+}
+
+TEST(CrtexTest,
+     ConvertibleExtensions)
+{
+    EXPECT_TRUE(IsConvertible("assets/bg/room.png"));
+    EXPECT_TRUE(IsConvertible("assets/bg/ROOM.JPG"));
+    EXPECT_FALSE(IsConvertible("assets/sounds/door.wav"));
+    EXPECT_FALSE(IsConvertible("assets/fonts/noext"));
+}
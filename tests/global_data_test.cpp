@@ -0,0 +1,107 @@
+// global_data_test.cpp — Tests for cross-playthrough data (read lines,
+// unlocks, endings) and the memory-mapped bitsets behind it
+
+#include "global_data.hpp"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+using namespace cereka;
+using scenario::Instruction;
+using scenario::Op;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct GlobalDataTest : ::testing::Test {
+    fs::path dir = fs::temp_directory_path() / "cereka_global_data_test";
+
+    void SetUp() override { fs::remove_all(dir); }
+    void TearDown() override { fs::remove_all(dir); }
+};
+
+Instruction line(const std::string &speaker,
+                 const std::string &text)
+{
+    Instruction ins{Op::SAY};
+    ins.a = speaker;
+    ins.b = text;
+    return ins;
+}
+
+}  // namespace
+
+TEST_F(GlobalDataTest,
+       SeenLinesSurviveReopenAndScriptEdits)
+{
+    std::vector<Instruction> v1 = {
+        line("alice", "Hi."), line("bob", "Hey."), line("alice", "Hi."), {Op::END}};
+    {
+        GlobalData g;
+        ASSERT_TRUE(g.Open(dir.string()));
+        g.BindProgram(v1);
+        g.MarkSeen(0);
+        g.MarkSeen(2);
+        EXPECT_TRUE(g.Seen(0));
+        EXPECT_FALSE(g.Seen(1));
+        EXPECT_FALSE(g.Seen(3));
+    }
+
+    // A line inserted at the top moves every pc, not the lines' identity.
+    std::vector<Instruction> v2 = {line("carol", "New line."), line("alice", "Hi."),
+                                   line("bob", "Hey."),        line("alice", "Hi."),
+                                   {Op::END}};
+    GlobalData g;
+    ASSERT_TRUE(g.Open(dir.string()));
+    g.BindProgram(v2);
+    EXPECT_FALSE(g.Seen(0));
+    EXPECT_TRUE(g.Seen(1));
+    EXPECT_FALSE(g.Seen(2));
+    EXPECT_TRUE(g.Seen(3));
+    EXPECT_EQ(g.SeenCount(), 2u);
+}
+
+TEST_F(GlobalDataTest,
+       UnlocksAndEndingsPersist)
+{
+    Instruction unlock{Op::UNLOCK};
+    unlock.a = "cg_beach";
+    {
+        GlobalData g;
+        ASSERT_TRUE(g.Open(dir.string()));
+        g.BindProgram({unlock});
+        EXPECT_FALSE(g.IsUnlocked("cg_beach"));
+        g.Unlock("cg_beach");
+        g.ReachEnding("good");  // not named by the script
+    }
+    GlobalData g;
+    ASSERT_TRUE(g.Open(dir.string()));
+    EXPECT_TRUE(g.IsUnlocked("cg_beach"));
+    EXPECT_FALSE(g.IsUnlocked("cg_forest"));
+    EXPECT_TRUE(g.HasReachedEnding("good"));
+    EXPECT_FALSE(g.HasReachedEnding("bad"));
+}
+
+TEST_F(GlobalDataTest,
+       BitsetGrowsPastOnePage)
+{
+    const std::uint32_t n = 100000;
+    {
+        MappedBitset bits;
+        ASSERT_TRUE(bits.Open((dir / "big").string()));
+        for (std::uint64_t k = 0; k < n; ++k)
+            ASSERT_EQ(bits.Index(k * 7919), k);
+        ASSERT_TRUE(bits.FlushKeys());
+        bits.Set(n - 1);
+        bits.Set(4096 * 8 + 3);
+        EXPECT_TRUE(bits.Sync());
+    }
+    MappedBitset bits;
+    ASSERT_TRUE(bits.Open((dir / "big").string()));
+    EXPECT_EQ(bits.Size(), n);
+    EXPECT_EQ(bits.Find((n - 1) * 7919ull), n - 1);
+    EXPECT_TRUE(bits.Test(n - 1));
+    EXPECT_TRUE(bits.Test(4096 * 8 + 3));
+    EXPECT_EQ(bits.Count(), 2u);
+    EXPECT_EQ(bits.Find(1), MappedBitset::NONE);
+}
@@ -0,0 +1,140 @@
+// hot_reload_test.cpp — Tests for dev-mode hot reload: carrying the pc into
+// an edited program and noticing script writes
+
+#include "hot_reload.hpp"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace cereka;
+using scenario::Instruction;
+using scenario::Op;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::size_t MAIN = 1;
+constexpr std::size_t INCLUDED = 2;
+
+Instruction at(Op op,
+               int line,
+               const std::string &a = {},
+               std::size_t file = MAIN)
+{
+    Instruction ins{op};
+    ins.a = a;
+    ins.srcLine = line;
+    ins.srcFile = file;
+    return ins;
+}
+
+// Write content and move the file's mtime on by a whole second, so the
+// change shows even where timestamps are coarse.
+void rewrite(const fs::path &p,
+             const std::string &content)
+{
+    auto before = fs::last_write_time(p);
+    std::ofstream(p) << content;
+    fs::last_write_time(p, before + std::chrono::seconds(1));
+}
+
+std::unordered_map<std::string, std::size_t> labelsOf(const std::vector<Instruction> &program)
+{
+    std::unordered_map<std::string, std::size_t> labels;
+    for (std::size_t i = 0; i < program.size(); ++i)
+        if (program[i].op == Op::LABEL)
+            labels[program[i].a] = i;
+    return labels;
+}
+
+}  // namespace
+
+TEST(MapProgramCounterTest,
+     FollowsLabelWhenLinesAboveItChange)
+{
+    std::vector<Instruction> before = {at(Op::SAY, 1),
+                                       at(Op::LABEL, 3, "ch5"),
+                                       at(Op::SAY, 4),
+                                       at(Op::SAY, 5),
+                                       at(Op::END, 6)};
+    // Ten lines inserted before the label and the current line reworded.
+    std::vector<Instruction> after = {at(Op::SAY, 1),
+                                      at(Op::SAY, 11),
+                                      at(Op::LABEL, 13, "ch5"),
+                                      at(Op::SAY, 14),
+                                      at(Op::SAY, 15),
+                                      at(Op::END, 16)};
+    EXPECT_EQ(MapProgramCounter(before, 3, after, labelsOf(after)), 4u);
+    EXPECT_EQ(MapProgramCounter(before, 1, after, labelsOf(after)), 2u);
+}
+
+TEST(MapProgramCounterTest,
+     DeletedLineContinuesWithWhatFollowed)
+{
+    std::vector<Instruction> before = {at(Op::LABEL, 1, "a"),
+                                       at(Op::SAY, 2),
+                                       at(Op::SAY, 3),
+                                       at(Op::LABEL, 5, "b"),
+                                       at(Op::SAY, 6)};
+    std::vector<Instruction> after = {
+        at(Op::LABEL, 1, "a"), at(Op::SAY, 2), at(Op::LABEL, 4, "b"), at(Op::SAY, 5)};
+    EXPECT_EQ(MapProgramCounter(before, 2, after, labelsOf(after)), 2u);
+}
+
+TEST(MapProgramCounterTest,
+     MissingLabelFallsBackToSourceLine)
+{
+    std::vector<Instruction> before = {at(Op::LABEL, 1, "old"), at(Op::SAY, 2), at(Op::SAY, 3)};
+    std::vector<Instruction> after = {at(Op::LABEL, 1, "new"), at(Op::SAY, 2), at(Op::SAY, 3)};
+    EXPECT_EQ(MapProgramCounter(before, 2, after, labelsOf(after)), 2u);
+    EXPECT_EQ(MapProgramCounter(before, 3, after, labelsOf(after)), after.size());
+}
+
+TEST(MapProgramCounterTest,
+     LinesMatchOnlyWithinTheirOwnFile)
+{
+    // Lines 3-4 of an included file follow the label at line 2 of the
+    // entry script; the entry script's own line 4 comes after them.
+    std::vector<Instruction> before = {at(Op::LABEL, 2, "a"),
+                                       at(Op::SAY, 3, {}, INCLUDED),
+                                       at(Op::SAY, 4, {}, INCLUDED),
+                                       at(Op::SAY, 4)};
+    // A line added above the label in the entry script shifts only its lines.
+    std::vector<Instruction> after = {at(Op::SAY, 1),
+                                      at(Op::LABEL, 3, "a"),
+                                      at(Op::SAY, 3, {}, INCLUDED),
+                                      at(Op::SAY, 4, {}, INCLUDED),
+                                      at(Op::SAY, 5)};
+    EXPECT_EQ(MapProgramCounter(before, 1, after, labelsOf(after)), 2u);
+    EXPECT_EQ(MapProgramCounter(before, 2, after, labelsOf(after)), 3u);
+    EXPECT_EQ(MapProgramCounter(before, 3, after, labelsOf(after)), 4u);
+}
+
+TEST(ScriptWatcherTest,
+     ReportsWritesToWatchedFilesOnly)
+{
+    fs::path dir = fs::temp_directory_path() / "cereka_hot_reload_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path script = dir / "main.crka";
+    std::ofstream(script) << "say a \"Hi.\"\n";
+
+    ScriptWatcher w;
+    ASSERT_TRUE(w.Watch({script.string()}));
+    EXPECT_FALSE(w.Changed());
+
+    std::ofstream(dir / "notes.txt") << "unrelated\n";
+    std::this_thread::sleep_for(ScriptWatcher::POLL_INTERVAL + std::chrono::milliseconds(20));
+    EXPECT_FALSE(w.Changed());
+
+    // Without inotify, the wait lets the next poll run.
+    rewrite(script, "say a \"Hello.\"\n");
+    std::this_thread::sleep_for(ScriptWatcher::POLL_INTERVAL + std::chrono::milliseconds(20));
+    EXPECT_TRUE(w.Changed());
+    EXPECT_FALSE(w.Changed());
+
+    w.Stop();
+    fs::remove_all(dir);
+}
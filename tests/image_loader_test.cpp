@@ -0,0 +1,88 @@
+// image_loader_test.cpp — Tests for load-time image downscaling
+//
+// Covers the fit-size rules and the CPU area resampler (no renderer needed).
+
+#include "image_loader.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace cereka::image_loader;
+
+TEST(ImageLoaderTest,
+     FitSizeNeverUpscales)
+{
+    int w = 0, h = 0;
+    FitSize(800, 600, 1920, 1080, w, h);
+    EXPECT_EQ(w, 800);
+    EXPECT_EQ(h, 600);
+
+    FitSize(800, 600, 0, 1080, w, h);
+    EXPECT_EQ(w, 800);
+    EXPECT_EQ(h, 600);
+}
+
+TEST(ImageLoaderTest,
+     FitSizeStretchFitsAxesIndependently)
+{
+    int w = 0, h = 0;
+    FitSize(3840, 2160, 1280, 720, w, h);
+    EXPECT_EQ(w, 1280);
+    EXPECT_EQ(h, 720);
+
+    FitSize(3840, 600, 1280, 720, w, h);
+    EXPECT_EQ(w, 1280);
+    EXPECT_EQ(h, 600);
+}
+
+TEST(ImageLoaderTest,
+     FitSizeDerivesMissingAxisFromAspect)
+{
+    int w = 0, h = 0;
+    FitSize(1000, 2000, 0, 576, w, h);
+    EXPECT_EQ(h, 576);
+    EXPECT_EQ(w, 288);
+}
+
+TEST(ImageLoaderTest,
+     ResampleAreaAveragesBlocks)
+{
+    // 2x2 -> 1x1: opaque black and white average to mid grey.
+    std::vector<Uint8> src = {
+        0, 0, 0, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 0, 0, 0, 255,
+    };
+    std::vector<Uint8> dst(4, 0);
+    ResampleArea(src.data(), 2, 2, 8, dst.data(), 1, 1, 4);
+    EXPECT_NEAR(dst[0], 128, 1);
+    EXPECT_NEAR(dst[1], 128, 1);
+    EXPECT_NEAR(dst[2], 128, 1);
+    EXPECT_EQ(dst[3], 255);
+}
+
+TEST(ImageLoaderTest,
+     ResampleAreaDoesNotBleedTransparentColor)
+{
+    // Fully transparent black next to opaque red must stay pure red, half alpha.
+    std::vector<Uint8> src = {
+        0, 0, 0, 0, 255, 0, 0, 255,
+    };
+    std::vector<Uint8> dst(4, 0);
+    ResampleArea(src.data(), 2, 1, 8, dst.data(), 1, 1, 4);
+    EXPECT_EQ(dst[0], 255);
+    EXPECT_EQ(dst[1], 0);
+    EXPECT_EQ(dst[2], 0);
+    EXPECT_NEAR(dst[3], 128, 1);
+}
+
+TEST(ImageLoaderTest,
+     ResampleAreaHandlesFractionalRatios)
+{
+    // 3 -> 2 columns: each output covers 1.5 source texels.
+    std::vector<Uint8> src = {
+        0, 0, 0, 255, 90, 90, 90, 255, 180, 180, 180, 255,
+    };
+    std::vector<Uint8> dst(8, 0);
+    ResampleArea(src.data(), 3, 1, 12, dst.data(), 2, 1, 8);
+    EXPECT_NEAR(dst[0], 30, 1);   // (0 * 1 + 90 * 0.5) / 1.5
+    EXPECT_NEAR(dst[4], 150, 1);  // (90 * 0.5 + 180 * 1) / 1.5
+}
@@ -0,0 +1,79 @@
+// latency_histogram_test.cpp — Tests for the input latency histogram:
+// bucket edges, percentiles and the report
+
+#include "latency_histogram.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace cereka;
+
+namespace {
+
+constexpr std::uint64_t MS = 1000000;
+
+}  // namespace
+
+TEST(LatencyHistogramTest,
+     BucketsCoverTheirEdges)
+{
+    EXPECT_EQ(LatencyHistogram::BucketOf(0), 0);
+    EXPECT_EQ(LatencyHistogram::BucketOf(1023999), 0);
+    EXPECT_EQ(LatencyHistogram::BucketOf(1024000), 1);
+    EXPECT_EQ(LatencyHistogram::BucketOf(60 * 1000 * MS), LatencyHistogram::BUCKETS - 1);
+
+    for (int b = 1; b < LatencyHistogram::BUCKETS - 1; ++b) {
+        double lo = LatencyHistogram::BucketLowerMs(b);
+        double hi = LatencyHistogram::BucketUpperMs(b);
+        ASSERT_LT(lo, hi);
+        EXPECT_EQ(LatencyHistogram::BucketOf((std::uint64_t)(lo * 1e6)), b);
+        EXPECT_EQ(LatencyHistogram::BucketOf((std::uint64_t)(hi * 1e6) - 1000), b);
+        EXPECT_LE((hi - lo) / lo, 1.0 / LatencyHistogram::SUB_BUCKETS + 1e-9);
+    }
+}
+
+TEST(LatencyHistogramTest,
+     SeparatesOneFrameFromTwo)
+{
+    // 60 Hz: one vsync interval vs two
+    EXPECT_NE(LatencyHistogram::BucketOf(16667 * 1000), LatencyHistogram::BucketOf(33333 * 1000));
+    EXPECT_NE(LatencyHistogram::BucketOf(16667 * 1000), LatencyHistogram::BucketOf(18000 * 1000));
+}
+
+TEST(LatencyHistogramTest,
+     PercentilesAndMean)
+{
+    LatencyHistogram h;
+    EXPECT_EQ(h.PercentileMs(0.5), 0.0);
+
+    for (int i = 0; i < 90; ++i)
+        h.Record(16 * MS);
+    for (int i = 0; i < 10; ++i)
+        h.Record(50 * MS);
+
+    EXPECT_EQ(h.Count(), 100u);
+    EXPECT_NEAR(h.MeanMs(), 19.4, 1e-9);
+    EXPECT_DOUBLE_EQ(h.MaxMs(), 50.0);
+
+    double p50 = h.PercentileMs(0.5);
+    EXPECT_GE(p50, 16.0);
+    EXPECT_LT(p50, 17.0);
+    EXPECT_DOUBLE_EQ(h.PercentileMs(0.99), 50.0);  // capped at the largest sample
+
+    h.Clear();
+    EXPECT_EQ(h.Count(), 0u);
+}
+
+TEST(LatencyHistogramTest,
+     ReportListsNonEmptyBuckets)
+{
+    LatencyHistogram h;
+    h.Record(16 * MS);
+    h.Record(16 * MS);
+    h.Record(5000 * MS);
+
+    std::string report = h.Report();
+    EXPECT_NE(report.find("3 samples"), std::string::npos);
+    EXPECT_EQ(std::count(report.begin(), report.end(), '\n'), 2);
+    EXPECT_NE(report.find(">="), std::string::npos);
+}
@@ -1,6 +1,7 @@
 // save_data_test.cpp — Tests for SerializableSaveData
 //
-// Tests Glaze JSON serialization/deserialization of game saves.
+// Tests Glaze JSON serialization/deserialization of game saves, and the
+// versioned binary format the engine writes to save slots.
 
 #include "save_data.hpp"
 #include <gtest/gtest.h>
@@ -122,3 +123,108 @@ TEST(SaveDataTest,
     EXPECT_TRUE(jsonToSaveData(data, ""));
     EXPECT_TRUE(jsonToSaveData(data, "{}"));
 }
+
+TEST(SaveDataTest,
+     BinaryRoundtripCarriesVersionAndMetadata)
+{
+    SerializableSaveData original;
+    original.version = 0;  // ignored by the encoder
+    original.timestamp = "2026-10-19 12:00";
+    original.label = "chapter3";
+    original.playtime = 4321.0;
+    original.programCounter = 77;
+    original.callStack = {3, 9};
+    original.variables["route"] = "b";
+    original.characters.push_back({"alice", "alice.png", "left"});
+
+    std::string bytes;
+    ASSERT_TRUE(saveDataToBinary(original, bytes));
+    ASSERT_GE(bytes.size(), 8u);
+    EXPECT_EQ(bytes.substr(0, 4), "CRSV");
+
+    SerializableSaveData loaded;
+    ASSERT_TRUE(binaryToSaveData(loaded, bytes));
+    EXPECT_EQ(loaded.version, SAVE_VERSION);
+    EXPECT_EQ(loaded.label, "chapter3");
+    EXPECT_DOUBLE_EQ(loaded.playtime, 4321.0);
+    EXPECT_EQ(loaded.programCounter, 77u);
+    EXPECT_EQ(loaded.callStack, (std::vector<size_t>{3, 9}));
+    EXPECT_EQ(loaded.variables["route"], "b");
+    ASSERT_EQ(loaded.characters.size(), 1u);
+    EXPECT_EQ(loaded.characters[0].position, "left");
+}
+
+TEST(SaveDataTest,
+     LegacyTextSavesAreMigrated)
+{
+    const std::string text = "timestamp=2024-01-15 14:30\n"
+                             "pc=12\n"
+                             "callstack=4,8\n"
+                             "var.score=100\n"
+                             "bg=room.png\n"
+                             "char.alice=alice.png:right\n"
+                             "bgm=theme.ogg\n"
+                             "state=1\n"
+                             "text=Hi=there\n"
+                             "skipMode=1\n";
+
+    SerializableSaveData loaded;
+    ASSERT_TRUE(binaryToSaveData(loaded, text));
+    EXPECT_EQ(loaded.version, SAVE_VERSION);
+    EXPECT_EQ(loaded.programCounter, 12u);
+    EXPECT_EQ(loaded.callStack, (std::vector<size_t>{4, 8}));
+    EXPECT_EQ(loaded.variables["score"], "100");
+    ASSERT_EQ(loaded.characters.size(), 1u);
+    EXPECT_EQ(loaded.characters[0].file, "alice.png");
+    EXPECT_EQ(loaded.characters[0].position, "right");
+    EXPECT_EQ(loaded.state, "1");
+    EXPECT_EQ(loaded.text, "Hi=there");
+    EXPECT_TRUE(loaded.skipMode);
+}
+
+TEST(SaveDataTest,
+     RejectsNewerVersionsAndGarbage)
+{
+    SerializableSaveData data;
+    std::string bytes;
+    ASSERT_TRUE(saveDataToBinary(data, bytes));
+
+    std::string newer = bytes;
+    newer[4] = (char)(SAVE_VERSION + 1);
+    EXPECT_FALSE(binaryToSaveData(data, newer));
+
+    EXPECT_FALSE(binaryToSaveData(data, "not a save"));
+}
+
+TEST(SaveDataTest,
+     DeltaCarriesOnlyChangesAndReappliesThem)
+{
+    SerializableSaveData before;
+    before.programCounter = 3;
+    before.variables = {{"a", "1"}, {"b", "2"}};
+    before.background = "room.png";
+    before.characters = {{"alice", "alice.png", "left"}};
+    before.bgm = "theme.ogg";
+
+    SerializableSaveData after = before;
+    after.programCounter = 9;
+    after.playtime = 12.5;
+    after.variables = {{"a", "5"}, {"c", "3"}};
+    after.characters[0].position = "right";
+
+    SerializableSaveDelta delta = diffSaveData(before, after);
+    EXPECT_EQ(delta.programCounter, 9u);
+    EXPECT_EQ(delta.setVariables.size(), 2u);
+    EXPECT_EQ(delta.erasedVariables, std::vector<std::string>{"b"});
+    EXPECT_FALSE(delta.callStack.has_value());
+    EXPECT_FALSE(delta.background.has_value());
+    EXPECT_TRUE(delta.characters.has_value());
+    EXPECT_FALSE(delta.bgm.has_value());
+
+    applySaveDelta(before, delta);
+    EXPECT_EQ(before.programCounter, after.programCounter);
+    EXPECT_DOUBLE_EQ(before.playtime, after.playtime);
+    EXPECT_EQ(before.variables, after.variables);
+    EXPECT_EQ(before.characters, after.characters);
+    EXPECT_EQ(before.background, "room.png");
+}
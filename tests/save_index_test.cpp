@@ -0,0 +1,97 @@
+// save_index_test.cpp — Tests for the save-slot metadata index
+
+#include "save_index.hpp"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using cereka::SaveIndex;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct SaveIndexTest : ::testing::Test {
+    fs::path dir = fs::temp_directory_path() / "cereka_save_index_test";
+
+    void SetUp() override
+    {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    void write(const std::string &name,
+               const std::string &content)
+    {
+        std::ofstream(dir / name) << content;
+    }
+};
+
+}  // namespace
+
+TEST_F(SaveIndexTest,
+       ReadsLegacyTextSaves)
+{
+    write("slot2.sav", "timestamp=2026-01-02 10:00\nlabel=chapter2\nplaytime=3725\npc=14\n");
+    write("slot3.sav", "pc=3\n");  // written before metadata existed
+
+    SaveIndex index(dir.string());
+    EXPECT_FALSE(index.Get(1).used);
+
+    const SaveIndex::Slot &s2 = index.Get(2);
+    EXPECT_TRUE(s2.used);
+    EXPECT_EQ(s2.timestamp, "2026-01-02 10:00");
+    EXPECT_EQ(s2.label, "chapter2");
+    EXPECT_DOUBLE_EQ(s2.playtime, 3725.0);
+
+    EXPECT_TRUE(index.Get(3).used);
+    EXPECT_EQ(index.Get(3).timestamp, "???");
+    EXPECT_FALSE(index.Get(0).used);
+}
+
+TEST_F(SaveIndexTest,
+       PutUpdatesInPlaceWithoutRereading)
+{
+    SaveIndex index(dir.string());
+    EXPECT_FALSE(index.Get(4).used);
+
+    // Files changed behind the index's back are not seen until Invalidate.
+    write("slot5.sav", "timestamp=later\n");
+    EXPECT_FALSE(index.Get(5).used);
+
+    SaveIndex::Slot s;
+    s.used = true;
+    s.timestamp = "now";
+    index.Put(4, s);
+    EXPECT_EQ(index.Get(4).timestamp, "now");
+
+    index.Invalidate();
+    EXPECT_EQ(index.Get(5).timestamp, "later");
+}
+
+TEST_F(SaveIndexTest,
+       PagesCoverHighestSlotAndReadOnlyWhatIsAsked)
+{
+    SaveIndex index(dir.string());
+    EXPECT_EQ(index.HighestUsed(), 0);
+    EXPECT_EQ(index.PageCount(), 1);
+
+    write("slot37.sav", "timestamp=late\n");
+    write("slot37.sav.tmp", "timestamp=partial\n");
+    write("slot37.crtex", "");
+    index.Invalidate();
+    EXPECT_EQ(index.HighestUsed(), 37);
+    EXPECT_EQ(index.PageCount(), 4);
+    EXPECT_EQ(SaveIndex::FirstSlotOfPage(3), 31);
+
+    // The listing only records that the slot exists; its file is read on Get.
+    write("slot37.sav", "timestamp=rewritten\n");
+    EXPECT_EQ(index.Get(37).timestamp, "rewritten");
+    EXPECT_FALSE(index.Get(36).used);
+
+    index.Put(39, SaveIndex::Slot{true, "now"});
+    EXPECT_EQ(index.PageCount(), 4);
+    index.Put(40, SaveIndex::Slot{true, "now"});  // page 4 full: one more to page onto
+    EXPECT_EQ(index.PageCount(), 5);
+}
@@ -0,0 +1,145 @@
+// save_journal_test.cpp — Tests for the append-only autosave journal
+//
+// The journal thread is only started where batching matters; elsewhere
+// every record is written inline.
+
+#include "save_data.hpp"
+#include "save_journal.hpp"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace cereka;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct SaveJournalTest : ::testing::Test {
+    fs::path dir = fs::temp_directory_path() / "cereka_save_journal_test";
+    std::string path = (dir / "autosave.journal").string();
+
+    void SetUp() override
+    {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+    void TearDown() override { fs::remove_all(dir); }
+};
+
+SerializableSaveData stateAt(size_t pc)
+{
+    SerializableSaveData s;
+    s.programCounter = pc;
+    s.playtime = pc * 2.0;
+    s.variables["pc"] = std::to_string(pc);
+    s.background = pc < 3 ? "room.png" : "street.png";
+    return s;
+}
+
+}  // namespace
+
+TEST_F(SaveJournalTest,
+       ReplaysSnapshotAndDeltas)
+{
+    SaveJournal journal(path);
+    for (size_t pc = 1; pc <= 5; ++pc)
+        journal.Record(stateAt(pc));
+
+    SerializableSaveData out;
+    ASSERT_TRUE(SaveJournal::Replay(path, out));
+    EXPECT_EQ(out.programCounter, 5u);
+    EXPECT_DOUBLE_EQ(out.playtime, 10.0);
+    EXPECT_EQ(out.variables["pc"], "5");
+    EXPECT_EQ(out.background, "street.png");
+}
+
+TEST_F(SaveJournalTest,
+       TornTailFallsBackToLastIntactRecord)
+{
+    SaveJournal journal(path);
+    journal.Record(stateAt(1));
+    journal.Record(stateAt(2));
+    auto intact = fs::file_size(path);
+    journal.Record(stateAt(3));
+
+    // Power lost halfway through the last append.
+    fs::resize_file(path, intact + (fs::file_size(path) - intact) / 2);
+
+    SerializableSaveData out;
+    ASSERT_TRUE(SaveJournal::Replay(path, out));
+    EXPECT_EQ(out.programCounter, 2u);
+    EXPECT_EQ(out.background, "room.png");
+}
+
+TEST_F(SaveJournalTest,
+       CompactionLeavesOneSnapshot)
+{
+    SaveJournal journal(path);
+    for (size_t pc = 1; pc <= 20; ++pc)
+        journal.Record(stateAt(pc));
+    auto appended = fs::file_size(path);
+
+    journal.Compact();
+    EXPECT_LT(fs::file_size(path), appended);
+
+    SerializableSaveData out;
+    ASSERT_TRUE(SaveJournal::Replay(path, out));
+    EXPECT_EQ(out.programCounter, 20u);
+}
+
+TEST_F(SaveJournalTest,
+       DiscardRemovesTheJournal)
+{
+    SaveJournal journal(path);
+    journal.Record(stateAt(1));
+    journal.Discard();
+
+    SerializableSaveData out;
+    EXPECT_FALSE(SaveJournal::Replay(path, out));
+    EXPECT_FALSE(fs::exists(path));
+
+    std::ofstream(path) << "not a journal";
+    EXPECT_FALSE(SaveJournal::Replay(path, out));
+}
+
+TEST_F(SaveJournalTest,
+       FailedDeltaEndsTheChainUntilTheNextSnapshot)
+{
+    SaveJournal journal(path);
+    journal.SetDeltaEncoder([](const SerializableSaveDelta &delta) {
+        if (delta.programCounter == 3)
+            return std::string();
+        auto bytes = glz::write_beve(delta);
+        return bytes ? *bytes : std::string();
+    });
+    journal.Start();
+    journal.Record(stateAt(1));
+    journal.Flush();
+
+    // One batch: the record for pc 3 fails to encode. It alone sets "seen",
+    // so replaying pc 4 on top of pc 2 would resume without it.
+    journal.Record(stateAt(2));
+    SerializableSaveData third = stateAt(3);
+    third.variables["seen"] = "yes";
+    journal.Record(third);
+    SerializableSaveData fourth = stateAt(4);
+    fourth.variables["seen"] = "yes";
+    journal.Record(fourth);
+    journal.Flush();
+
+    SerializableSaveData out;
+    ASSERT_TRUE(SaveJournal::Replay(path, out));
+    EXPECT_EQ(out.programCounter, 2u);
+    EXPECT_EQ(out.variables.count("seen"), 0u);
+
+    // The next record is a snapshot, so the journal is whole again.
+    SerializableSaveData fifth = stateAt(5);
+    fifth.variables["seen"] = "yes";
+    journal.Record(fifth);
+    journal.Flush();
+    ASSERT_TRUE(SaveJournal::Replay(path, out));
+    EXPECT_EQ(out.programCounter, 5u);
+    EXPECT_EQ(out.variables["seen"], "yes");
+    journal.Stop();
+}
@@ -0,0 +1,145 @@
+// save_writer_test.cpp — Tests for the background save writer: deferred
+// encoding, replacing queued writes and the pending state of a slot
+
+#include "save_writer.hpp"
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+using namespace cereka;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct SaveWriterTest : ::testing::Test {
+    fs::path dir = fs::temp_directory_path() / "cereka_save_writer_test";
+    std::string path = (dir / "slot1.sav").string();
+
+    void SetUp() override
+    {
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    static std::string read(const std::string &p)
+    {
+        std::ifstream in(p, std::ios::binary);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+// Holds the writer thread inside a producer until the test lets it go.
+struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool entered = false;
+    bool open = false;
+
+    std::string wait(std::string bytes)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        entered = true;
+        cv.notify_all();
+        cv.wait(lock, [this] { return open; });
+        return bytes;
+    }
+    void waitEntered()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return entered; });
+    }
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = true;
+        cv.notify_all();
+    }
+};
+
+}  // namespace
+
+TEST_F(SaveWriterTest,
+       WriteWithProducesInlineWhenNotStarted)
+{
+    SaveWriter writer;
+    writer.WriteWith(path, [] { return std::string("inline"); });
+    EXPECT_FALSE(writer.Pending(path));
+    EXPECT_EQ(read(path), "inline");
+}
+
+TEST_F(SaveWriterTest,
+       EmptyResultWritesNothing)
+{
+    SaveWriter writer;
+    writer.Write(path, "kept");
+    writer.WriteWith(path, [] { return std::string(); });
+    EXPECT_EQ(read(path), "kept");
+
+    writer.Start();
+    writer.WriteWith(path, [] { return std::string(); });
+    writer.Flush();
+    EXPECT_EQ(read(path), "kept");
+    EXPECT_FALSE(fs::exists(path + ".tmp"));
+}
+
+TEST_F(SaveWriterTest,
+       PendingUntilTheWriteLands)
+{
+    SaveWriter writer;
+    writer.Start();
+    Gate gate;
+    writer.WriteWith(path, [&] { return gate.wait("first"); });
+    gate.waitEntered();
+    EXPECT_TRUE(writer.Pending(path));
+    EXPECT_FALSE(writer.Pending((dir / "slot2.sav").string()));
+
+    gate.release();
+    writer.Flush();
+    EXPECT_FALSE(writer.Pending(path));
+    EXPECT_EQ(read(path), "first");
+}
+
+TEST_F(SaveWriterTest,
+       QueuedWriteToTheSamePathIsReplaced)
+{
+    SaveWriter writer;
+    writer.Start();
+    std::string other = (dir / "slot2.sav").string();
+    Gate gate;
+    int produced = 0;
+    // The worker is busy with slot2, so both slot1 writes wait in the queue.
+    writer.WriteWith(other, [&] { return gate.wait("other"); });
+    gate.waitEntered();
+    writer.WriteWith(path, [&] {
+        ++produced;
+        return std::string("stale");
+    });
+    writer.WriteWith(path, [&] {
+        ++produced;
+        return std::string("fresh");
+    });
+    EXPECT_TRUE(writer.Pending(path));
+
+    gate.release();
+    writer.Flush();
+    EXPECT_EQ(produced, 1);  // the replaced write was never encoded
+    EXPECT_EQ(read(path), "fresh");
+    EXPECT_EQ(read(other), "other");
+}
+
+TEST_F(SaveWriterTest,
+       StopFinishesQueuedWrites)
+{
+    SaveWriter writer;
+    writer.Start();
+    writer.WriteWith(path, [] { return std::string("late"); });
+    writer.Stop();
+    EXPECT_EQ(read(path), "late");
+}
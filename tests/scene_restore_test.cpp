@@ -0,0 +1,167 @@
+// scene_restore_test.cpp — Tests for loading a save over the resident scene:
+// SceneManager::Restore changes only what differs, and the BGM is kept when
+// the saved track is already the one playing
+//
+// Textures come from a TextureCache with a fake loader and a zero budget, so
+// every released texture is destroyed at once and a reload shows up as a
+// second load. No renderer is needed.
+
+#include "audio_manager.hpp"
+#include "scene_manager.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace cereka;
+
+class SceneRestoreTest : public ::testing::Test {
+   protected:
+    void SetUp() override
+    {
+        cache.Init(
+            [this](const AssetPrefetcher::Request &req, size_t &bytes) -> SDL_Texture * {
+                ++loads[req.path];
+                bytes = 100;
+                auto [it, added] = handles.try_emplace(req.path, handles.size() + 1);
+                return (SDL_Texture *)(std::uintptr_t)(it->second * 16);
+            },
+            [this](SDL_Texture *tex) {
+                for (auto &[path, id] : handles)
+                    if ((std::uintptr_t)tex == id * 16)
+                        destroyed.push_back(path);
+            });
+        cache.SetBudget(0);
+        scene.Init(nullptr, &cache);
+        scene.SetTargetSize(1280, 720);
+    }
+
+    void TearDown() override
+    {
+        scene.Shutdown();
+        cache.Shutdown();
+    }
+
+    static bool has(const std::vector<std::string> &v,
+                    const std::string &s)
+    {
+        return std::find(v.begin(), v.end(), s) != v.end();
+    }
+
+    TextureCache cache;
+    SceneManager scene;
+    std::map<std::string, std::uintptr_t> handles;
+    std::map<std::string, int> loads;
+    std::vector<std::string> destroyed;
+};
+
+TEST_F(SceneRestoreTest,
+       RestoresADifferentBackgroundAndCast)
+{
+    scene.ShowBackground("room.png");
+    scene.ShowCharacter("alice", "alice.png", "left");
+    scene.ShowCharacter("bob", "bob.png", "right");
+    scene.ShowCharacter("carol", "carol.png", "center");
+    SDL_Texture *alice = scene.Characters().at("alice").tex;
+
+    scene.Restore("street.png",
+                  {{"alice", "alice.png", "right"},
+                   {"bob", "bob_angry.png", "right"},
+                   {"dave", "dave.png", "left"}});
+
+    EXPECT_EQ(scene.BgPath(), "street.png");
+    EXPECT_EQ(scene.Background(), cache.Acquire(scene.BackgroundRequest("street.png")));
+    cache.Release(scene.Background());
+    EXPECT_TRUE(has(destroyed, "assets/bg/room.png"));
+
+    // alice only moved: same texture, never loaded again.
+    ASSERT_EQ(scene.Characters().count("alice"), 1u);
+    EXPECT_EQ(scene.Characters().at("alice").tex, alice);
+    EXPECT_FLOAT_EQ(scene.Characters().at("alice").xNorm, SceneManager::posToXNorm("right"));
+    EXPECT_EQ(loads["assets/characters/alice.png"], 1);
+    EXPECT_FALSE(has(destroyed, "assets/characters/alice.png"));
+
+    // bob changed sprite, carol left, dave arrived.
+    EXPECT_EQ(scene.CharPaths().at("bob"), "bob_angry.png");
+    EXPECT_TRUE(has(destroyed, "assets/characters/bob.png"));
+    EXPECT_EQ(scene.Characters().count("carol"), 0u);
+    EXPECT_EQ(scene.CharPaths().count("carol"), 0u);
+    EXPECT_TRUE(has(destroyed, "assets/characters/carol.png"));
+    EXPECT_EQ(scene.CharPaths().at("dave"), "dave.png");
+    EXPECT_EQ(scene.Characters().size(), 3u);
+}
+
+TEST_F(SceneRestoreTest,
+       RestoringTheSameSceneLoadsNothing)
+{
+    scene.ShowBackground("room.png");
+    scene.ShowCharacter("alice", "alice.png", "left");
+    SDL_Texture *bg = scene.Background();
+
+    scene.Restore("room.png", {{"alice", "alice.png", "left"}});
+
+    EXPECT_EQ(scene.Background(), bg);
+    EXPECT_EQ(loads["assets/bg/room.png"], 1);
+    EXPECT_EQ(loads["assets/characters/alice.png"], 1);
+    EXPECT_TRUE(destroyed.empty());
+}
+
+TEST_F(SceneRestoreTest,
+       EmptySaveClearsTheScene)
+{
+    scene.ShowBackground("room.png");
+    scene.ShowCharacter("alice", "alice.png", "left");
+
+    scene.Restore("", {});
+
+    EXPECT_EQ(scene.Background(), nullptr);
+    EXPECT_TRUE(scene.BgPath().empty());
+    EXPECT_TRUE(scene.Characters().empty());
+    EXPECT_EQ(destroyed.size(), 2u);
+}
+
+TEST_F(SceneRestoreTest,
+       FadeRecordsTheIncomingBackground)
+{
+    scene.ShowBackground("day.png");
+    scene.StartFade("night.png", 1.0f);
+    EXPECT_EQ(scene.BgPath(), "day.png");
+
+    scene.TickFade(0.6f);
+    EXPECT_EQ(scene.Phase(), SceneManager::FadePhase::In);
+    EXPECT_EQ(scene.BgPath(), "night.png");
+    EXPECT_TRUE(has(destroyed, "assets/bg/day.png"));
+}
+
+TEST_F(SceneRestoreTest,
+       RestoreMidFadeKeepsTheIncomingBackground)
+{
+    scene.ShowBackground("day.png");
+    scene.StartFade("night.png", 1.0f);
+
+    // Loading a save taken on the fade's target finishes the fade instead of
+    // loading that background a second time.
+    scene.Restore("night.png", {});
+
+    EXPECT_EQ(scene.Phase(), SceneManager::FadePhase::None);
+    EXPECT_EQ(scene.BgPath(), "night.png");
+    EXPECT_NE(scene.Background(), nullptr);
+    EXPECT_EQ(loads["assets/bg/night.png"], 1);
+    EXPECT_TRUE(has(destroyed, "assets/bg/day.png"));
+}
+
+TEST(AudioRestoreTest,
+     KeepsTheSavedTrackWhenItIsPlayingOrLoading)
+{
+    EXPECT_TRUE(AudioManager::KeepsBgm("theme.ogg", "theme.ogg", ""));
+    EXPECT_TRUE(AudioManager::KeepsBgm("boss.ogg", "theme.ogg", "boss.ogg"));
+    // Playing theme while boss loads: the save's theme stays, boss is dropped.
+    EXPECT_TRUE(AudioManager::KeepsBgm("theme.ogg", "theme.ogg", "boss.ogg"));
+    EXPECT_FALSE(AudioManager::KeepsBgm("theme.ogg", "boss.ogg", ""));
+    // A track that failed to load is neither playing nor loading.
+    EXPECT_FALSE(AudioManager::KeepsBgm("theme.ogg", "", ""));
+    EXPECT_FALSE(AudioManager::KeepsBgm("", "", ""));
+}
@@ -0,0 +1,93 @@
+// sfx_pool_test.cpp — Tests for the sound effect voice pool and cache:
+// voice stealing, the per-sound cap and least-recently-used eviction
+
+#include "sfx_pool.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace cereka::sfx_pool;
+
+namespace {
+
+const std::string DOOR = "door.wav";
+const std::string STEP = "step.wav";
+const std::string HIT = "hit.wav";
+
+}  // namespace
+
+TEST(SfxPoolTest,
+     IdleVoiceIsPreferred)
+{
+    std::vector<VoiceState> voices = {
+        {&DOOR, 1, true},
+        {&STEP, 2, false},  // finished playing
+        {nullptr, 0, false},
+    };
+    EXPECT_EQ(PickVoice(voices, &HIT, 4), 1);
+}
+
+TEST(SfxPoolTest,
+     OldestVoiceIsStolenWhenAllAreBusy)
+{
+    std::vector<VoiceState> voices = {
+        {&DOOR, 5, true},
+        {&STEP, 2, true},
+        {&DOOR, 9, true},
+    };
+    EXPECT_EQ(PickVoice(voices, &HIT, 4), 1);
+}
+
+TEST(SfxPoolTest,
+     SoundAtItsCapReusesItsOwnOldestVoice)
+{
+    std::vector<VoiceState> voices = {
+        {&STEP, 1, true},
+        {&DOOR, 4, true},
+        {&DOOR, 3, true},
+        {nullptr, 0, false},
+    };
+    EXPECT_EQ(PickVoice(voices, &DOOR, 2), 2);
+    EXPECT_EQ(PickVoice(voices, &DOOR, 3), 3);
+}
+
+TEST(SfxPoolTest,
+     UnusableVoicesAreSkipped)
+{
+    std::vector<VoiceState> voices = {
+        {nullptr, 0, false, false},
+        {&DOOR, 1, true},
+    };
+    EXPECT_EQ(PickVoice(voices, &HIT, 4), 1);
+    voices[1].usable = false;
+    EXPECT_EQ(PickVoice(voices, &HIT, 4), -1);
+}
+
+TEST(SfxPoolTest,
+     LeastRecentlyUsedSoundIsEvictedOverBudget)
+{
+    Lru lru;
+    lru.Touch(&DOOR, 40);
+    lru.Touch(&STEP, 30);
+    lru.Touch(&DOOR);  // played again: now the most recent
+    lru.Touch(&HIT, 50);
+    EXPECT_EQ(lru.Resident(), 120u);
+
+    EXPECT_TRUE(lru.TakeOverBudget(120).empty());
+    EXPECT_EQ(lru.TakeOverBudget(100), (std::vector<const std::string *>{&STEP}));
+    EXPECT_EQ(lru.Resident(), 90u);
+    EXPECT_EQ(lru.TakeOverBudget(60), (std::vector<const std::string *>{&DOOR}));
+    EXPECT_EQ(lru.Size(), 1u);
+}
+
+TEST(SfxPoolTest,
+     MostRecentSoundSurvivesATinyBudget)
+{
+    Lru lru;
+    lru.Touch(&DOOR, 40);
+    lru.Touch(&HIT, 500);
+    EXPECT_EQ(lru.TakeOverBudget(100), (std::vector<const std::string *>{&DOOR}));
+    EXPECT_EQ(lru.Size(), 1u);
+    EXPECT_EQ(lru.Resident(), 500u);
+    EXPECT_TRUE(lru.TakeOverBudget(100).empty());
+}
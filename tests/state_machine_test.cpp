@@ -0,0 +1,110 @@
+// state_machine_test.cpp — Tests for the static-dispatch state machine:
+// transitions, overlay stack and what each overlay draws over
+
+#include "state/cereka_state.hpp"
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace cereka;
+
+namespace {
+
+struct Recorder {
+    std::string log;
+};
+
+template<CerekaState S,
+         bool Overlay = false>
+struct Probe : VNState<Recorder, S, Overlay> {
+    static void onEnter(Recorder &r) { r.log += "+" + std::to_string((int)S); }
+    static void onExit(Recorder &r) { r.log += "-" + std::to_string((int)S); }
+    static void handleEvent(Recorder &r,
+                            const CerekaEvent &)
+    {
+        r.log += "e" + std::to_string((int)S);
+    }
+    static void draw(Recorder &r) { r.log += "d" + std::to_string((int)S); }
+};
+
+// Fading keeps the default no-op hooks.
+using Machine = CerekaStateMachine<Recorder,
+                                   Probe<CerekaState::Running>,
+                                   Probe<CerekaState::WaitingForInput>,
+                                   Probe<CerekaState::InMenu>,
+                                   VNState<Recorder, CerekaState::Fading>,
+                                   Probe<CerekaState::Finished>,
+                                   Probe<CerekaState::Quit>,
+                                   Probe<CerekaState::SaveMenuState, true>,
+                                   Probe<CerekaState::LoadMenuState, true>>;
+
+}  // namespace
+
+TEST(StateMachineTest,
+     ChangeStateRunsExitThenEnter)
+{
+    Recorder r;
+    Machine sm{r};
+    EXPECT_EQ(sm.currentType(), CerekaState::Running);
+
+    sm.changeState(CerekaState::InMenu);
+    EXPECT_EQ(r.log, "-0+2");
+    sm.changeState(CerekaState::InMenu);  // unchanged: no hooks
+    EXPECT_EQ(r.log, "-0+2");
+
+    sm.changeState(CerekaState::Fading);  // default hooks do nothing
+    EXPECT_EQ(r.log, "-0+2-2");
+    EXPECT_EQ(sm.baseType(), CerekaState::Fading);
+}
+
+TEST(StateMachineTest,
+     TopOverlayTakesInputAndDraw)
+{
+    Recorder r;
+    Machine sm{r};
+    sm.changeState(CerekaState::WaitingForInput);
+    r.log.clear();
+
+    ASSERT_TRUE(sm.pushOverlay(CerekaState::SaveMenuState));
+    ASSERT_TRUE(sm.pushOverlay(CerekaState::LoadMenuState));
+    EXPECT_EQ(sm.currentType(), CerekaState::LoadMenuState);
+    EXPECT_EQ(sm.baseType(), CerekaState::WaitingForInput);
+
+    r.log.clear();
+    sm.handleEvent({});
+    sm.draw();
+    EXPECT_EQ(r.log, "e7d7");
+
+    // What each overlay sits on
+    r.log.clear();
+    sm.drawBelow(0);
+    EXPECT_EQ(r.log, "d1");
+    r.log.clear();
+    sm.drawBelow(1);
+    EXPECT_EQ(r.log, "d1d6");
+
+    r.log.clear();
+    sm.popOverlay();
+    sm.handleEvent({});
+    EXPECT_EQ(r.log, "-7e6");
+
+    sm.clearOverlays();
+    EXPECT_FALSE(sm.hasOverlays());
+    EXPECT_EQ(sm.currentType(), CerekaState::WaitingForInput);
+}
+
+TEST(StateMachineTest,
+     RejectsMisplacedStates)
+{
+    Recorder r;
+    Machine sm{r};
+
+    EXPECT_FALSE(sm.pushOverlay(CerekaState::InMenu));  // not an overlay
+    sm.changeState(CerekaState::SaveMenuState);         // overlays are pushed
+    EXPECT_EQ(sm.baseType(), CerekaState::Running);
+
+    for (std::size_t i = 0; i < Machine::MAX_OVERLAYS; ++i)
+        ASSERT_TRUE(sm.pushOverlay(CerekaState::SaveMenuState));
+    EXPECT_FALSE(sm.pushOverlay(CerekaState::SaveMenuState));
+    EXPECT_EQ(r.log, "+6+6+6+6");
+}
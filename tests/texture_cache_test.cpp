@@ -0,0 +1,163 @@
+// texture_cache_test.cpp — Tests for the shared texture cache: reference
+// counting, least-recently-used eviction, the byte budget and dropping a
+// rewritten file
+//
+// Textures are fake handles from a loader that records what it made and
+// what the cache destroyed, so no renderer is needed.
+
+#include "texture_cache.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace cereka;
+
+class TextureCacheTest : public ::testing::Test {
+   protected:
+    void SetUp() override
+    {
+        cache.Init(
+            [this](const AssetPrefetcher::Request &req, size_t &bytes) -> SDL_Texture * {
+                ++loads[req.path];
+                bytes = 100;
+                return handle(req.maxW ? req.path + '@' + std::to_string(req.maxW) : req.path);
+            },
+            [this](SDL_Texture *tex) { destroyed.push_back(pathOf(tex)); });
+    }
+
+    void TearDown() override { cache.Shutdown(); }
+
+    static AssetPrefetcher::Request req(const std::string &path,
+                                        int fit = 0)
+    {
+        return {AssetPrefetcher::Request::Kind::Image, path, fit, fit};
+    }
+
+    SDL_Texture *handle(const std::string &path)
+    {
+        auto [it, added] = handles.try_emplace(path, handles.size() + 1);
+        return (SDL_Texture *)(std::uintptr_t)(it->second * 16);
+    }
+
+    std::string pathOf(SDL_Texture *tex) const
+    {
+        for (auto &[path, id] : handles)
+            if ((std::uintptr_t)tex == id * 16)
+                return path;
+        return "?";
+    }
+
+    TextureCache cache;
+    std::map<std::string, std::uintptr_t> handles;
+    std::map<std::string, int> loads;
+    std::vector<std::string> destroyed;
+};
+
+TEST_F(TextureCacheTest,
+       RetainAndReleasePairUp)
+{
+    cache.SetBudget(0);  // anything unreferenced goes at once
+    SDL_Texture *a = cache.Acquire(req("a.png"));
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(cache.Acquire(req("a.png")), a);
+    cache.Retain(a);
+    EXPECT_EQ(loads["a.png"], 1);
+
+    cache.Release(a);
+    cache.Release(a);
+    EXPECT_TRUE(destroyed.empty());
+    cache.Release(a);
+    EXPECT_EQ(destroyed, (std::vector<std::string>{"a.png"}));
+    EXPECT_FALSE(cache.Contains(req("a.png")));
+
+    // Releasing again, or releasing something the cache never made, is ignored.
+    cache.Release(a);
+    cache.Release(nullptr);
+    EXPECT_EQ(destroyed.size(), 1u);
+}
+
+TEST_F(TextureCacheTest,
+       UnreferencedTexturesStayUntilTheBudgetNeedsThem)
+{
+    SDL_Texture *a = cache.Acquire(req("a.png"));
+    cache.Release(a);
+    EXPECT_TRUE(cache.Contains(req("a.png")));
+    EXPECT_EQ(cache.Acquire(req("a.png")), a);
+    EXPECT_EQ(loads["a.png"], 1);
+    cache.Release(a);
+}
+
+TEST_F(TextureCacheTest,
+       EvictsLeastRecentlyReleasedFirstAndKeepsToBudget)
+{
+    SDL_Texture *a = cache.Acquire(req("a.png"));
+    SDL_Texture *b = cache.Acquire(req("b.png"));
+    SDL_Texture *c = cache.Acquire(req("c.png"));
+    cache.Release(b);
+    cache.Release(a);
+    cache.Release(c);
+    // a is used again, so it is the most recent when released.
+    cache.Release(cache.Acquire(req("a.png")));
+    EXPECT_EQ(cache.ResidentBytes(), 300u);
+
+    cache.SetBudget(150);
+    EXPECT_EQ(destroyed, (std::vector<std::string>{"b.png", "c.png"}));
+    EXPECT_LE(cache.ResidentBytes(), cache.Budget());
+    EXPECT_TRUE(cache.Contains(req("a.png")));
+
+    // A new texture over budget pushes out the oldest unreferenced one.
+    cache.SetBudget(100);
+    SDL_Texture *d = cache.Acquire(req("d.png"));
+    EXPECT_EQ(destroyed.back(), "a.png");
+    EXPECT_EQ(cache.ResidentBytes(), 100u);
+    cache.Release(d);
+}
+
+TEST_F(TextureCacheTest,
+       ReferencedTexturesAreNeverEvicted)
+{
+    SDL_Texture *pinned = cache.Acquire(req("pinned.png"));
+    SDL_Texture *other = cache.Acquire(req("other.png"));
+    cache.Release(other);
+
+    cache.SetBudget(0);
+    EXPECT_EQ(destroyed, (std::vector<std::string>{"other.png"}));
+    EXPECT_TRUE(cache.Contains(req("pinned.png")));
+    EXPECT_EQ(cache.ResidentBytes(), 100u);  // over budget while it is needed
+
+    cache.Release(pinned);
+    EXPECT_EQ(destroyed.back(), "pinned.png");
+    EXPECT_EQ(cache.ResidentBytes(), 0u);
+}
+
+TEST_F(TextureCacheTest,
+       EvictDropsEveryUnreferencedSizeOfAPath)
+{
+    SDL_Texture *full = cache.Acquire(req("a.png"));
+    SDL_Texture *small = cache.Acquire(req("a.png", 64));
+    SDL_Texture *held = cache.Acquire(req("a.png", 128));
+    SDL_Texture *similar = cache.Acquire(req("a.png.old"));
+    cache.Release(full);
+    cache.Release(small);
+    cache.Release(similar);
+
+    EXPECT_EQ(loads["a.png"], 3);
+    cache.Evict("a.png");
+    std::sort(destroyed.begin(), destroyed.end());
+    EXPECT_EQ(destroyed, (std::vector<std::string>{"a.png", "a.png@64"}));
+    EXPECT_FALSE(cache.Contains(req("a.png")));
+    EXPECT_FALSE(cache.Contains(req("a.png", 64)));
+    // A texture still in use survives, as does a path that only shares a prefix.
+    EXPECT_TRUE(cache.Contains(req("a.png", 128)));
+    EXPECT_TRUE(cache.Contains(req("a.png.old")));
+    EXPECT_EQ(cache.ResidentBytes(), 200u);
+
+    // The next Acquire reads the file again.
+    cache.Release(cache.Acquire(req("a.png")));
+    EXPECT_EQ(loads["a.png"], 4);
+    cache.Release(held);
+}
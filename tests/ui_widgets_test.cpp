@@ -0,0 +1,86 @@
+// ui_widgets_test.cpp — Tests for the retained widget tree: hit testing,
+// pointer activation and keyboard focus (no renderer needed)
+
+#include "ui_widgets.hpp"
+#include <gtest/gtest.h>
+
+using namespace cereka::ui;
+
+namespace {
+
+Widget button(int id,
+              float y,
+              int parent = -1)
+{
+    Widget w;
+    w.kind = Widget::Kind::Button;
+    w.id = id;
+    w.parent = parent;
+    w.rect = {100.0f, y, 200.0f, 40.0f};
+    return w;
+}
+
+}  // namespace
+
+TEST(WidgetTreeTest,
+     HitTestFindsTopmostButton)
+{
+    WidgetTree tree;
+    Widget panel;
+    panel.rect = {0.0f, 0.0f, 800.0f, 600.0f};
+    tree.Add(panel);
+    int a = tree.Add(button(1, 100.0f));
+    int b = tree.Add(button(2, 120.0f));  // overlaps the lower half of a
+
+    EXPECT_EQ(tree.HitTest(150.0f, 110.0f), a);
+    EXPECT_EQ(tree.HitTest(150.0f, 130.0f), b);
+    EXPECT_EQ(tree.HitTest(10.0f, 10.0f), -1);  // boxes are not hit
+}
+
+TEST(WidgetTreeTest,
+     ReleaseActivatesOnlyThePressedButton)
+{
+    WidgetTree tree;
+    int a = tree.Add(button(1, 100.0f));
+    tree.Add(button(2, 200.0f));
+
+    EXPECT_TRUE(tree.PointerMove(150.0f, 110.0f));
+    EXPECT_TRUE(tree.At(a).hover);
+    EXPECT_FALSE(tree.PointerMove(160.0f, 115.0f));  // still over a
+
+    ASSERT_TRUE(tree.PointerDown(150.0f, 110.0f));
+    EXPECT_TRUE(tree.At(a).pressed);
+    EXPECT_EQ(tree.PointerUp(150.0f, 110.0f), a);
+    EXPECT_FALSE(tree.At(a).pressed);
+
+    // Pressed on a, released on b: nothing fires.
+    tree.PointerDown(150.0f, 110.0f);
+    EXPECT_EQ(tree.PointerUp(150.0f, 210.0f), -1);
+
+    // Released without a press (the click that opened the screen)
+    EXPECT_EQ(tree.PointerUp(150.0f, 110.0f), -1);
+}
+
+TEST(WidgetTreeTest,
+     FocusWrapsAndSkipsHiddenButtons)
+{
+    WidgetTree tree;
+    int a = tree.Add(button(1, 100.0f));
+    int group = tree.Add(Widget{});
+    int b = tree.Add(button(2, 200.0f, group));
+    int c = tree.Add(button(3, 300.0f));
+
+    EXPECT_EQ(tree.Focused(), -1);
+    tree.MoveFocus(1);
+    EXPECT_EQ(tree.Focused(), a);
+    tree.MoveFocus(1);
+    EXPECT_EQ(tree.Focused(), b);
+    tree.MoveFocus(-1);
+    tree.MoveFocus(-1);
+    EXPECT_EQ(tree.Focused(), c);
+
+    tree.SetVisible(group, false);
+    tree.MoveFocus(-1);
+    EXPECT_EQ(tree.Focused(), a);
+    EXPECT_EQ(tree.HitTest(150.0f, 210.0f), -1);
+}